@@ -12,6 +12,10 @@ namespace glib
 	{
 		bool manageAssets = true; // Turning this flag off is not recommended
 		bool noDecorations = false;
+		bool textureAtlas = false; // Packs small textures into shared atlas pages so sprites can be batched together. Atlased textures clamp instead of using GL_REPEAT, so tiling them through the uvs doesn't work
+		int textureAtlasThreshold = 256; // Textures with a width or height above this are never packed
+		int textureAtlasPageSize = 2048;
+		std::string shaderCacheDirectory = ""; // Linked shader programs are stored here and reused on the next start, empty turns it off
 	};
 
 	class InstanceImpl;
@@ -1385,16 +1385,58 @@
 
 namespace glib
 {
+	/**
+	* Counters of the OpenGL calls that went through the OpenGLProxy during one frame.
+	*/
+	struct GLIB_API OpenGLProxyStats
+	{
+		unsigned int calls = 0; // Calls that actually reached OpenGL
+		unsigned int filtered = 0; // Calls that were dropped because the state was already set
+		unsigned int drawCalls = 0;
+	};
+
+	/**
+	* Every OpenGL state change of glib goes through here. The proxy keeps a shadow copy of the state
+	* (capabilities, blend function, viewport, clear color, program, vertex array, framebuffers and the 2D texture of every unit)
+	* and drops calls that wouldn't change anything.
+	* If you call OpenGL directly (e.g. in a custom Drawable), call InvalidateState afterwards.
+	*/
 	class OpenGLProxy
 	{
 	public:
 		GLIB_API static void Enable(int glenum);
+		GLIB_API static void Disable(int glenum);
 		GLIB_API static void BlendFunc(int glenum1, int glenum2);
 		GLIB_API static void Viewport(int x, int y, int w, int h);
 		GLIB_API static void ClearColor(float r, float g, float b, float a);
 		GLIB_API static void Clear(int bufferbits);
 		GLIB_API static void ActiveTexture(int glenum);
-		GLIB_API static void DrawArrays(int glenum, int first, int count);
+		GLIB_API static void BindTexture(int target, unsigned int texture);
+		GLIB_API static void DeleteTextures(int n, const unsigned int* textures);
+		GLIB_API static void UseProgram(unsigned int program);
+		GLIB_API static void DeleteProgram(unsigned int program);
 		GLIB_API static void BindVertexArray(int vao);
+		GLIB_API static void DeleteVertexArrays(int n, const unsigned int* vaos);
+		GLIB_API static void BindFramebuffer(int target, unsigned int fbo);
+		GLIB_API static void DeleteFramebuffers(int n, const unsigned int* fbos);
+		GLIB_API static void DrawArrays(int glenum, int first, int count);
+		GLIB_API static void DrawArraysInstanced(int glenum, int first, int count, int instances);
+		GLIB_API static void DrawElements(int glenum, int count, int type, const void* indices);
+		GLIB_API static void DrawElementsBaseVertex(int glenum, int count, int type, const void* indices, int baseVertex);
+		GLIB_API static void DrawArraysInstancedBaseInstance(int glenum, int first, int count, int instances, unsigned int baseInstance);
+
+		/**
+		* Forgets the shadow state, so the next call of every kind reaches OpenGL again.
+		* Needed after changing OpenGL state without the proxy.
+		*/
+		GLIB_API static void InvalidateState();
+
+		/**
+		* @returns the call counters of the last finished frame
+		*/
+		GLIB_API static const OpenGLProxyStats& GetStats();
+
+		static void MakeCurrent(void* context); // Internal (the shadow state is only valid for one context)
+		static void EndFrame(); // Internal
 	};
 }
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "../DLLDefs.h"
+
+#include <string>
+#include <cstdint>
+
+namespace glib
+{
+	class ProgramCacheImpl;
+
+	/**
+	* Stores linked shader programs on disk (glGetProgramBinary), so the next start doesn't have to compile them again.
+	* A file is named after the hash of the sources and also records the OpenGL vendor, renderer and version it was made with.
+	* Binaries from another driver, or ones the driver rejects, are ignored and replaced after compiling.
+	* Programs have to be linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT for Store to work.
+	*/
+	class ProgramCache
+	{
+	private:
+		ProgramCacheImpl* impl;
+	public:
+		/**
+		* @param directory[in] - Where the binaries are kept, created on the first Store
+		*/
+		GLIB_API ProgramCache(const std::string& directory);
+		GLIB_API ~ProgramCache();
+
+		/**
+		* Creates a program from a cached binary. Needs the OpenGL context.
+		*
+		* @param vertexCode[in] - The code of the vertex shader
+		* @param fragmentCode[in] - The code of the fragment shader
+		* @returns The linked program or 0 if there is no usable binary
+		*/
+		GLIB_API unsigned int Load(const std::string& vertexCode, const std::string& fragmentCode);
+
+		/**
+		* Writes the binary of a linked program. Failing to write is not an error, the program is just compiled again next time.
+		*
+		* @param program[in] - The linked program
+		* @param vertexCode[in] - The code of the vertex shader
+		* @param fragmentCode[in] - The code of the fragment shader
+		*/
+		GLIB_API void Store(unsigned int program, const std::string& vertexCode, const std::string& fragmentCode);
+
+		/**
+		* @returns Whether the driver supports program binaries at all (checked on the first Load)
+		*/
+		GLIB_API bool IsSupported() const;
+
+		/**
+		* @param source[in] - Shader code
+		* @returns The 64 bit FNV-1a hash of the code
+		*/
+		GLIB_API static uint64_t Hash(const std::string& source);
+	};
+}
\ No newline at end of file
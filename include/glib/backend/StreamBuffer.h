@@ -0,0 +1,77 @@
+#pragma once
+
+#include "../DLLDefs.h"
+
+#include <cstddef>
+
+#define GLIB_STREAM_BUFFER_SEGMENTS 4
+
+namespace glib
+{
+	class StreamBufferImpl;
+
+	/**
+	* A ring buffer for geometry that is rewritten every frame. Every write goes behind the previous one, so the GPU can still read
+	* older data while new data is written.
+	* With OpenGL 4.4 (or ARB_buffer_storage) the buffer is mapped once (persistent and coherent) and fence syncs make sure a region
+	* isn't overwritten before the GPU is done with it. Otherwise the buffer is orphaned every time it wraps around.
+	*/
+	class StreamBuffer
+	{
+	private:
+		StreamBufferImpl* impl;
+	public:
+		/**
+		* @param size[in] - The size of the buffer in bytes (should fit a few frames worth of data)
+		* @param target[in] - The buffer target (e.g. GL_ARRAY_BUFFER)
+		*/
+		GLIB_API StreamBuffer(size_t size, int target);
+		GLIB_API ~StreamBuffer();
+
+		/**
+		* Copies data into the buffer. The draw calls reading it have to be issued before the next call to Write.
+		*
+		* @param data[in] - The data
+		* @param size[in] - The size of the data in bytes (at most GetSize())
+		* @param alignment[in] - The returned offset is a multiple of this (e.g. the vertex size, so it can be used as a base vertex)
+		* @returns The offset in bytes the data was written to
+		*/
+		GLIB_API size_t Write(const void* data, size_t size, size_t alignment = 1);
+
+		/**
+		* Reserves a range of the buffer to be written directly, e.g. by several threads at once. Only the calls to Map and Unmap need the OpenGL context.
+		* Unmap has to be called before drawing from the range and before the next Map or Write.
+		*
+		* @param size[in] - The size of the range in bytes (at most GetSize())
+		* @param alignment[in] - The offset is a multiple of this
+		* @param offset[out] - The offset in bytes of the range
+		* @returns A pointer to the range or nullptr if it couldn't be mapped
+		*/
+		GLIB_API void* Map(size_t size, size_t alignment, size_t& offset);
+
+		/**
+		* Finishes the range reserved by the last Map call.
+		*/
+		GLIB_API void Unmap();
+
+		/**
+		* @returns The OpenGL buffer id
+		*/
+		GLIB_API unsigned int GetID() const;
+
+		/**
+		* @returns The size of the buffer in bytes
+		*/
+		GLIB_API size_t GetSize() const;
+
+		/**
+		* @returns Whether the buffer is persistently mapped (false if the orphaning fallback is used)
+		*/
+		GLIB_API bool IsPersistent() const;
+
+		/**
+		* @returns How often a write had to wait for the GPU to finish reading a region (should stay at 0 if the buffer is big enough)
+		*/
+		GLIB_API unsigned int GetStallCount() const;
+	};
+}
\ No newline at end of file
@@ -15,6 +15,7 @@ namespace glib
 	struct FBInternals
 	{
 		unsigned int tex;
+		unsigned int fbo;
 		//unsigned int RBO;
 	};
 
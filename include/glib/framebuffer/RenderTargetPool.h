@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../DLLDefs.h"
+#include "../math/Vec2.h"
+#include "Framebuffer.h"
+
+#include <cstddef>
+
+namespace glib
+{
+	class RenderTargetPoolImpl;
+
+	/**
+	* Transient framebuffers shared by the pipeline elements of a window (see Window::GetRenderTargetPool).
+	* An element acquires a target for its output and releases its input once it has drawn, so a chain of effects
+	* ping-pongs between two targets instead of every element owning a full size one.
+	* Targets that weren't used during a frame are deleted at its end, so after a resize the old size is freed once
+	* and the new one allocated on first use, no matter how many resize events there were.
+	*/
+	class RenderTargetPool
+	{
+	private:
+		RenderTargetPoolImpl* impl;
+	public:
+		GLIB_API RenderTargetPool();
+		GLIB_API ~RenderTargetPool();
+
+		/**
+		* Returns a target that isn't in use, creating one if there is none of that size and type.
+		* The contents are undefined, so it should be cleared before drawing.
+		*
+		* @param size[in] - The size in pixels
+		* @param type[in] - The type of the framebuffer
+		* @returns The target, owned by the pool
+		*/
+		GLIB_API Framebuffer* Acquire(const Vec2& size, FramebufferType type = FramebufferType::TEXTURE);
+
+		/**
+		* Hands a target back to the pool, so it can be acquired again.
+		*
+		* @param target[in] - A target returned by Acquire
+		*/
+		GLIB_API void Release(Framebuffer* target);
+
+		/**
+		* Releases the target whose color texture is the given one. Does nothing for textures that don't belong to the pool,
+		* so an element can release its input (PipelineData::uI) without knowing where it came from.
+		*
+		* @param texture[in] - The OpenGL texture id
+		*/
+		GLIB_API void ReleaseTexture(unsigned int texture);
+
+		/**
+		* Keeps a target across frames, e.g. the cached output of a retained camera (see Camera::SetRetained).
+		* Until UnretainTexture it can't be acquired and Release, ReleaseTexture and EndFrame leave it alone.
+		*
+		* @param texture[in] - The color texture of an acquired target
+		*/
+		GLIB_API void RetainTexture(unsigned int texture);
+
+		/**
+		* Hands a retained target back to the pool.
+		*
+		* @param texture[in] - The color texture of a retained target
+		*/
+		GLIB_API void UnretainTexture(unsigned int texture);
+
+		/**
+		* Looks up the target whose color texture is the given one.
+		*
+		* @param texture[in] - The OpenGL texture id
+		* @param size[out] - The size of the target, untouched if there is none
+		* @returns The target, nullptr if the texture doesn't belong to the pool
+		*/
+		GLIB_API Framebuffer* FindTarget(unsigned int texture, Vec2& size) const;
+
+		/**
+		* Releases every target and deletes the ones that weren't acquired since the last call. Called by the window once per frame.
+		*/
+		GLIB_API void EndFrame();
+
+		/**
+		* @returns The amount of targets currently allocated
+		*/
+		GLIB_API size_t GetTargetCount() const;
+	};
+}
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include "utils/Easing.h"
 #include "utils/Color.h"
 #include "utils/Utils.h"
+#include "utils/ThreadPool.h"
 #include "sound/SoundManager.h"
 #include "sound/Sound.h"
 #include "sound/AudioDataSource.h"
@@ -31,22 +32,38 @@
 #include "math/Rect.h"
 #include "math/Vec2.h"
 #include "math/Vec2i.h"
+#include "math/VecBatch.h"
+#include "math/Affine2D.h"
 #include "graphics/Texture.h"
+#include "graphics/TextureAtlas.h"
+#include "graphics/TextureRequest.h"
+#include "graphics/AtlasPacker.h"
 #include "graphics/Text.h"
 #include "graphics/Sprite.h"
 #include "graphics/Shader.h"
 #include "graphics/Font.h"
 #include "graphics/Drawable.h"
+#include "graphics/camera/SpatialHash.h"
 #include "graphics/video/VideoPlayer.h"
+#include "graphics/postprocessing/BloomEffect.h"
 #include "graphics/postprocessing/ChromaticEffect.h"
 #include "graphics/postprocessing/CRTEffect.h"
+#include "graphics/postprocessing/EffectStage.h"
+#include "graphics/postprocessing/FusedEffect.h"
 #include "graphics/postprocessing/PostProcessing.h"
 #include "graphics/postprocessing/SpeedLinesEffect.h"
 #include "graphics/pipeline/CameraRenderer.h"
 #include "graphics/pipeline/PipelineElement.h"
 #include "graphics/pipeline/RenderPipeline.h"
 #include "graphics/pipeline/WindowRenderer.h"
+#include "graphics/pipeline/SpriteBatch.h"
+#include "graphics/pipeline/SpriteInstancer.h"
+#include "graphics/pipeline/RenderQueue.h"
+#include "graphics/pipeline/FramePacket.h"
 #include "framebuffer/Framebuffer.h"
+#include "framebuffer/RenderTargetPool.h"
+#include "backend/ProgramCache.h"
+#include "backend/StreamBuffer.h"
 #include "event/Event.h"
 #include "event/EventManager.h"
 #include "event/EventSubscriber.h"
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../DLLDefs.h"
+#include "../math/Vec2i.h"
+
+namespace glib
+{
+	class AtlasPackerImpl;
+
+	/**
+	* A skyline (bottom-left) rectangle packer. It only does the bookkeeping and doesn't touch OpenGL,
+	* so it can be used and tested without a GPU.
+	*/
+	class AtlasPacker
+	{
+	private:
+		AtlasPackerImpl* impl;
+	public:
+		GLIB_API AtlasPacker(int width, int height);
+		GLIB_API ~AtlasPacker();
+
+		/**
+		* Finds a free spot for a rectangle and marks it as used.
+		* 
+		* @param width[in] - The width of the rectangle
+		* @param height[in] - The height of the rectangle
+		* @param outPos[out] - The top left position of the packed rectangle
+		* 
+		* @returns Wether the rectangle fits into the remaining space
+		*/
+		GLIB_API bool Pack(int width, int height, Vec2i& outPos);
+
+		/**
+		* Frees all packed rectangles.
+		*/
+		GLIB_API void Reset();
+
+		/**
+		* @returns The used area divided by the total area (0.0 - 1.0)
+		*/
+		GLIB_API float GetOccupancy() const;
+
+		GLIB_API int GetWidth() const;
+		GLIB_API int GetHeight() const;
+	};
+}
\ No newline at end of file
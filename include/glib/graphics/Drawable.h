@@ -1,6 +1,15 @@
 #pragma once
 
 #include "../DLLDefs.h"
+#include "../math/Vec2.h"
+#include "../math/Rect.h"
+#include <cstdint>
+
+#define GLIB_DRAWABLE_CUSTOM 0x0
+#define GLIB_DRAWABLE_SPRITE 0x1
+#define GLIB_DRAWABLE_TEXT 0x2
+#define GLIB_DRAWABLE_VIDEO_PLAYER 0x3
+#define GLIB_DRAWABLE_OBJECT_3D 0x4
 
 namespace glib
 {
@@ -8,8 +17,21 @@ namespace glib
 	{
 	public:
 		bool visible;
+		uint8_t kind = GLIB_DRAWABLE_CUSTOM; // Lets the renderers dispatch without RTTI (custom drawables are drawn through Draw)
+		bool isStatic = false; // Hint that this drawable doesn't move. Cameras with spatial hashing only place it once (see Camera::SetSpatialHashing)
+		int layer = 0; // Only used when the renderer sorts its drawables (see CameraRenderer::SetRenderQueue). Higher layers are drawn on top
 	public:
 		GLIB_API virtual void Draw() = 0;
 		GLIB_API virtual void Update(float delta) = 0;
+
+		/**
+		* Calculates the rectangle this drawable covers, in the same space as Camera::CalculateViewRect. Used for culling.
+		* Drawables that return false are never culled.
+		*
+		* @param cameraPos[in] - The position of the camera that draws this drawable
+		* @param zoom[in] - The zoom of the camera that draws this drawable
+		* @param bounds[out] - The covered rectangle (may be larger than the drawable, but never smaller)
+		*/
+		virtual bool GetBounds(const Vec2&, float, Rect&) { return false; }
 	};
 }
\ No newline at end of file
@@ -12,10 +12,12 @@ namespace glib
 	*/
 	struct GLIB_API Glyph
 	{
-		unsigned int tex;
+		unsigned int tex; // The atlas page containing this glyph
 		Vec2 size;
 		Vec2 bearing;
 		unsigned int advance;
+		Vec2 uvPos; // The normalized position of this glyph inside the atlas page
+		Vec2 uvSize;
 	};
 
 	class FontImpl;
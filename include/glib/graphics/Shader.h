@@ -7,6 +7,20 @@
 
 namespace glib
 {
+	/**
+	* A resolved uniform location. Get it once with Shader::GetUniform and pass it to the Set functions
+	* instead of the name to skip the string and the location lookup.
+	*/
+	struct UniformHandle
+	{
+		int location = -1;
+
+		/**
+		* @returns false if the uniform doesn't exist (or was optimized out), setting it is a no-op then
+		*/
+		bool IsValid() const { return location != -1; }
+	};
+
 	class ShaderImpl;
 
 	class Shader
@@ -24,5 +38,20 @@ namespace glib
 		GLIB_API void SetColor(const std::string& name, const Color& color);
 		GLIB_API void SetFloat(const std::string& name, float f);
 		GLIB_API void SetVec2(const std::string& name, const Vec2& vec);
+
+		/**
+		* Looks up a uniform. All active uniforms are already known after linking, so this never asks the driver.
+		*
+		* @param name[in] - The name of the uniform
+		* @returns a handle for the Set functions below
+		*/
+		GLIB_API UniformHandle GetUniform(const std::string& name);
+		GLIB_API void SetMat4(UniformHandle uniform, Mat4& mat);
+		GLIB_API void SetInt(UniformHandle uniform, int i);
+		GLIB_API void SetColor(UniformHandle uniform, const Color& color);
+		GLIB_API void SetFloat(UniformHandle uniform, float f);
+		GLIB_API void SetVec2(UniformHandle uniform, const Vec2& vec);
+
+		void CopyUniforms(Shader* target); // Internal (sets the uniforms that target shares with this shader to their values here, target has to be in use)
 	};
 }
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include "../utils/Color.h"
 #include "../animation/Animation.h"
 #include "../physics/PhysicsObject.h"
+#include "../math/Affine2D.h"
 
 #include <string>
 #include <map>
@@ -53,6 +54,7 @@ namespace glib
 
 		GLIB_API void Draw() override; // Does absolutley nothing.
 		GLIB_API void Update(float delta) override; // Actually does something.
+		GLIB_API bool GetBounds(const Vec2& cameraPos, float zoom, Rect& bounds) override;
 
 		/**
 		* Tweens the position of this sprite.
@@ -141,5 +143,24 @@ namespace glib
 		GLIB_API void SetDefaultAnimation(const std::string& name);
 		GLIB_API const Animation* GetCurrentAnimation() const;
 		GLIB_API const std::string& GetCurrentAnimationName() const;
+
+		/**
+		* The transform from the unit square to this sprite without camera scroll (see MakeSpriteTransform).
+		* It's cached and only recomputed when pos, size, scale, offset, rotation or a flip changed since the last call.
+		*/
+		GLIB_API const Affine2D& GetWorldTransform();
+
+		/**
+		* @returns The bounds of GetWorldTransform (cached the same way)
+		*/
+		GLIB_API const Rect& GetWorldBounds();
+
+		/**
+		* @returns A counter that goes up every time the cached transform is recomputed
+		*/
+		GLIB_API unsigned int GetTransformVersion();
+
+		bool IsTransformDirty() const; // Internal
+		void SetWorldTransform(const Affine2D& transform); // Internal (stores a transform computed elsewhere, e.g. in a batch)
 	};
 }
\ No newline at end of file
@@ -8,8 +8,20 @@
 #include "../utils/Easing.h"
 #include "Font.h"
 
+#include <vector>
+
 namespace glib
 {
+	/**
+	* A range of the cached text mesh that uses the same atlas page.
+	*/
+	struct TextMeshRange
+	{
+		unsigned int tex;
+		int first;
+		int count;
+	};
+
 	class TextImpl;
 
 	class Text : public Drawable
@@ -49,6 +61,7 @@ namespace glib
 
 		GLIB_API void Draw() override; // Does absolutley nothing.
 		GLIB_API virtual void Update(float delta) override; // Does actually something.
+		GLIB_API bool GetBounds(const Vec2& cameraPos, float zoom, Rect& bounds) override;
 
 		/**
 		* Sets the text of this text object.
@@ -62,6 +75,21 @@ namespace glib
 		*/
 		GLIB_API const std::wstring& GetText();
 
+		/**
+		* @returns The area covered by the glyphs without camera scroll. Cached, only recomputed when the mesh or the position changed
+		*/
+		GLIB_API const Rect& GetWorldBounds();
+
+		/**
+		* @returns A counter that goes up every time the mesh or the position changed
+		*/
+		GLIB_API unsigned int GetTransformVersion();
+
+		void UpdateMesh(); // Internal (rebuilds the cached glyph mesh if the text, font, scale, offset or rotation changed)
+		unsigned int GetMeshVAO(); // Internal
+		const std::vector<TextMeshRange>& GetMeshRanges(); // Internal
+		const std::vector<float>& GetMeshVertices(); // Internal (rebuilds the mesh on the CPU only, so it doesn't need the OpenGL context)
+
 		// See Sprite for tweening
 
 		GLIB_API void TweenPosition(const Vec2& to, float time, const Easing& easing, float delay = 0.0f);
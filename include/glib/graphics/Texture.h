@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../DLLDefs.h"
+#include "../math/Vec2.h"
 
 namespace glib
 {
@@ -25,12 +26,28 @@ namespace glib
 		int height;
 	public:
 		Texture(unsigned int id, int width, int height);
+		Texture(unsigned int id, int width, int height, const Vec2& uvOffset, const Vec2& uvSize); // Internal (atlas region)
 		~Texture();
 
 		GLIB_API void Bind();
 		GLIB_API void Unbind();
 		GLIB_API unsigned int GetID();
 
+		/**
+		* @returns The normalized top left position of this texture inside its OpenGL texture. (0, 0) unless this is an atlas region.
+		*/
+		GLIB_API const Vec2& GetUVOffset() const;
+
+		/**
+		* @returns The normalized size of this texture inside its OpenGL texture. (1, 1) unless this is an atlas region.
+		*/
+		GLIB_API const Vec2& GetUVSize() const;
+
+		/**
+		* @returns Wether this texture only references a region of a shared atlas page
+		*/
+		GLIB_API bool IsAtlasRegion() const;
+
 		void SetDeleteID(bool deleteID);
 
 		friend class AnimationImpl;
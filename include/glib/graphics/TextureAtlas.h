@@ -0,0 +1,45 @@
+#pragma once
+
+#include "../DLLDefs.h"
+#include "Texture.h"
+
+#include <cstddef>
+
+namespace glib
+{
+	class TextureAtlasImpl;
+
+	/**
+	* Packs small images into shared atlas pages (OpenGL textures), so sprites using them can be batched together.
+	* The returned textures only reference a sub-rectangle of a page (see Texture::GetUVOffset and Texture::GetUVSize).
+	* 
+	* Atlas textures are meant for 2D sprites. They don't repeat and have no mipmaps.
+	*/
+	class TextureAtlas
+	{
+	private:
+		TextureAtlasImpl* impl;
+	public:
+		/**
+		* @param pageSize[in] - The width and height of a single atlas page
+		* @param pixelart[in] - Wether the pages should be treated as pixel art (disables antialiasing)
+		* @param padding[in] - The border in pixels around each image. It repeats the edge pixels, so filtering neither bleeds into neighbours nor fades the edges
+		*/
+		GLIB_API TextureAtlas(int pageSize = 2048, bool pixelart = false, int padding = 2);
+		GLIB_API ~TextureAtlas();
+
+		/**
+		* Copies the image into a page. A new page is created when no existing page has enough space left.
+		* 
+		* @param data[in] - The image data (RGBA)
+		* 
+		* @returns A texture referencing the packed region or nullptr if the image is larger than a page
+		*/
+		GLIB_API Texture* Add(const ImageData& data);
+
+		/**
+		* @returns The amount of pages (OpenGL textures) in this atlas
+		*/
+		GLIB_API size_t GetPageCount() const;
+	};
+}
\ No newline at end of file
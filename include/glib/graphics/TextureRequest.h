@@ -0,0 +1,67 @@
+#pragma once
+
+#include "../DLLDefs.h"
+#include "Texture.h"
+
+#include <string>
+#include <functional>
+
+namespace glib
+{
+	enum class TextureLoadState
+	{
+		Decoding,
+		Uploading,
+		Done,
+		Failed
+	};
+
+	/**
+	* Called on the thread running Window::Update once an asynchronous load finished. The texture is nullptr if the load failed.
+	*/
+	typedef std::function<void(Texture* texture)> TextureCallback;
+
+	class TextureRequestImpl;
+
+	/**
+	* The handle of a texture that is loaded in the background (see Window::LoadTextureAsync).
+	* The state can be read from any thread.
+	*/
+	class TextureRequest
+	{
+	private:
+		TextureRequestImpl* impl;
+	public:
+		TextureRequest(const std::string& path); // Internal
+		~TextureRequest(); // Internal
+
+		/**
+		* @returns The current state of the load
+		*/
+		GLIB_API TextureLoadState GetState() const;
+
+		/**
+		* @returns Whether the load is over (Done or Failed)
+		*/
+		GLIB_API bool IsDone() const;
+
+		/**
+		* @returns The loaded texture, nullptr until the state is Done
+		*/
+		GLIB_API Texture* GetTexture() const;
+
+		/**
+		* @returns How much of the image is uploaded, from 0 to 1
+		*/
+		GLIB_API float GetProgress() const;
+
+		/**
+		* @returns The path of the image file
+		*/
+		GLIB_API const std::string& GetPath() const;
+
+		void SetProgress(float progress); // Internal
+		void Finish(Texture* texture); // Internal (texture is nullptr on failure)
+		void SetUploading(); // Internal
+	};
+}
\ No newline at end of file
@@ -5,11 +5,18 @@
 #include "../../math/Mat4.h"
 #include "../../utils/Easing.h"
 #include "../../math/Vec2.h"
+#include "../../math/Rect.h"
 
 #include <vector>
 
 namespace glib
 {
+	struct GLIB_API CullStats
+	{
+		unsigned int submitted = 0; // Drawables that were handed to the renderer
+		unsigned int culled = 0; // Drawables that were skipped because they were outside of the view
+	};
+
 	class CameraImpl;
 
 	class Camera
@@ -32,6 +39,61 @@ namespace glib
 		GLIB_API std::vector<Drawable*>& GetDrawables();
 		GLIB_API Mat4 CalculateView();
 
+		/**
+		* Calculates the area that is visible through this camera, in the space drawables are placed in after
+		* the camera position is subtracted (so it only depends on zoom and rotation).
+		* It is the bounding box of the rotated view, so it can be a bit larger than what is actually visible.
+		*/
+		GLIB_API Rect CalculateViewRect();
+
+		/**
+		* Enables or disables culling. Drawables whose bounds (see Drawable::GetBounds) are completely outside
+		* of the view rect are skipped by the renderer. Enabled by default.
+		*
+		* @param toggle[in] - Wether to enable or disable culling
+		*/
+		GLIB_API void SetCulling(bool toggle);
+		GLIB_API bool IsCulling() const;
+
+		/**
+		* Enables or disables the spatial hash for static drawables (Drawable::isStatic, set before adding them).
+		* Static sprites that scroll with the camera are placed in a grid once, so only the cells around the view
+		* are looked at each frame. Everything else is tested one by one. Useful for large levels.
+		* Drawables that are hashed are drawn in the order they were added.
+		*
+		* @param toggle[in] - Wether to enable or disable spatial hashing
+		* @param cellSize[in] - The size of one grid cell in world units
+		*/
+		GLIB_API void SetSpatialHashing(bool toggle, float cellSize = 512.0f);
+
+		/**
+		* Places a static drawable in the spatial hash again, e.g. after it was moved.
+		*
+		* @param drawable[in] - The drawable that changed
+		*/
+		GLIB_API void RefreshStatic(Drawable* drawable);
+
+		/**
+		* @returns how many drawables were submitted and culled when this camera was drawn the last time
+		*/
+		GLIB_API const CullStats& GetCullStats() const;
+
+		/**
+		* A retained camera keeps its rendered output (after the effects of the pipeline) and reuses it while nothing
+		* in it changed, so only the final composite runs. Meant for HUDs, menus and paused states.
+		* Changes are detected on sprites (transform, color, texture, animation frame, visibility) and texts
+		* (text, font, transform, color, visibility). A camera that contains other drawables is redrawn every frame.
+		* Effects that animate on their own (e.g. CRT) freeze while the output is reused. Disabled by default.
+		*
+		* @param toggle[in] - Wether to enable or disable retained mode
+		*/
+		GLIB_API void SetRetained(bool toggle);
+		GLIB_API bool IsRetained() const;
+
+		const std::vector<Drawable*>& GatherVisible(); // Internal (culls the drawables in draw order and updates the stats)
+		const std::vector<Drawable*>& GetUnhashedDrawables(); // Internal (drawables that aren't in the spatial hash, all of them without spatial hashing)
+		bool CalculateSignature(uint64_t& signature); // Internal (fingerprint of everything that is drawn, false if changes can't be detected)
+
 		void Update(float delta);
 
 		GLIB_API void TweenPosition(const Vec2& to, float time, const Easing& easing);
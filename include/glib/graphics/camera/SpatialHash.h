@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../../DLLDefs.h"
+#include "../Drawable.h"
+#include "../../math/Rect.h"
+
+#include <vector>
+#include <cstdint>
+
+namespace glib
+{
+	struct SpatialHashEntry
+	{
+		Drawable* drawable;
+		Rect bounds;
+		uint64_t order; // Used to restore the draw order after a query
+	};
+
+	class SpatialHashImpl;
+
+	/**
+	* A uniform grid that maps world rectangles to the drawables inside them.
+	* Used by cameras to find the drawables of large levels that are on screen without testing every single one.
+	*/
+	class SpatialHash
+	{
+	private:
+		SpatialHashImpl* impl;
+	public:
+		GLIB_API SpatialHash(float cellSize = 512.0f);
+		GLIB_API ~SpatialHash();
+
+		/**
+		* Adds a drawable (or moves it if it was already added).
+		*
+		* @param drawable[in] - The drawable
+		* @param bounds[in] - The world rectangle the drawable covers
+		* @param order[in] - The draw order of the drawable
+		*/
+		GLIB_API void Insert(Drawable* drawable, const Rect& bounds, uint64_t order);
+
+		GLIB_API void Remove(Drawable* drawable);
+		GLIB_API void Clear();
+
+		/**
+		* Finds every drawable whose bounds overlap the given area. Every drawable is returned only once.
+		*
+		* @param area[in] - The world rectangle to search
+		* @param out[out] - The found entries are appended to this (in no particular order)
+		*/
+		GLIB_API void Query(const Rect& area, std::vector<SpatialHashEntry>& out);
+
+		GLIB_API size_t GetCount() const;
+		GLIB_API float GetCellSize() const;
+	};
+}
\ No newline at end of file
@@ -1,29 +1,162 @@
 #pragma once
 
 #include "PipelineRenderer.h"
+#include "SpriteBatch.h"
+#include "SpriteInstancer.h"
+#include "RenderQueue.h"
+#include "FramePacket.h"
 #include "../Sprite.h"
 #include "../Text.h"
 #include "../video/VideoPlayer.h"
+#include "../../math/Affine2D.h"
+
+#include <vector>
 
 #define GLIB_PE_CAMERA_RENDERER 0x1
 
 namespace glib
 {
+	/**
+	* How the CameraRenderer draws sprites.
+	*/
+	enum class GLIB_API SpriteRenderMode
+	{
+		DEFAULT, // One draw call per sprite
+		BATCHED, // Sprites are transformed on the CPU and written into one streaming vertex buffer (see SpriteBatch)
+		INSTANCED // Sprites are uploaded as instance data and transformed in the vertex shader (see SpriteInstancer)
+	};
+
+	struct GLIB_API SpriteTransformStats
+	{
+		unsigned int batched = 0; // Sprite transforms updated in one pass before culling (SIMD, on the workers for long runs)
+		unsigned int late = 0; // Sprites that changed after that pass and were updated while drawing (should stay at 0, apart from static sprites in a spatial hash)
+	};
+
+	class StreamBuffer;
+	class ThreadPool;
+
 	class CameraRenderer : public PipelineRenderer
 	{
 	private:
 		Shader* m_TextShd;
-		unsigned int m_VAOx;
-		unsigned int m_VBOx;
+		Shader* m_BatchShd;
+		SpriteBatch* m_Batch;
+		Shader* m_InstanceShd;
+		SpriteInstancer* m_Instancer;
+		SpriteRenderMode m_SpriteMode;
+		std::vector<Sprite*> m_BatchedSprites;
+		std::vector<Sprite*> m_DirtySprites;
+		Vec2 m_BatchCameraPos;
+		SpriteTransformBatch m_BatchedTransforms;
+		std::vector<Affine2D> m_BatchedAffines;
+		std::vector<unsigned int> m_BatchedTextures;
+		ThreadPool* m_Workers;
+		SpriteTransformStats m_TransformStats;
+		RenderQueue* m_Queue;
+		bool m_UseQueue;
+		unsigned int m_PacketTextVAO;
+		StreamBuffer* m_PacketTextStream;
+		UniformHandle m_ViewUniform;
+		UniformHandle m_ModelUniform;
+		UniformHandle m_ColorUniform;
+		UniformHandle m_UVCoordUniform;
+		UniformHandle m_UVSizeUniform;
+		UniformHandle m_TextureUniform;
+		UniformHandle m_TextViewUniform;
+		UniformHandle m_TextModelUniform;
+		UniformHandle m_TextColorUniform;
+		UniformHandle m_BatchViewUniform;
+		UniformHandle m_InstanceViewUniform;
 	public:
 		GLIB_API CameraRenderer();
 		~CameraRenderer() override;
 
 		void Construct(Window* wnd) override;
 		const PipelineData Downstream(const PipelineData data) override;
-		void DrawSprite(Sprite* sprite, const Vec2& cameraPos, float zoom);
-		void DrawText(Text* text, const Vec2& cameraPos, float zoom);
-		void DrawVideoPlayer(VideoPlayer* player);
+		void DrawSprite(Sprite* sprite, const Vec2& cameraPos, float zoom); // Expects the sprite shader to be in use
+		void DrawText(Text* text, const Vec2& cameraPos, float zoom); // Expects the text shader to be in use
+		void DrawVideoPlayer(VideoPlayer* player); // Expects the sprite shader to be in use
+		void BatchSprite(Sprite* sprite, const Vec2& cameraPos);
+		void InstanceSprite(Sprite* sprite, const Vec2& cameraPos);
+		void SubmitBatchedSprites(); // Internal
+		void UpdateSpriteTransforms(Camera* cam); // Internal (before culling, so the bounds are read from the cache)
+		void UpdateDirtyTransforms(); // Internal
+		void BuildBatchVertices(size_t begin, size_t end, BatchVertex* out); // Internal (safe to call from several threads on disjoint ranges)
+		void FlushSprites();
+		void DrawDrawable(Drawable* d, Camera* cam, Shader*& current); // Internal
+		uint64_t MakeSortKey(Drawable* d) const; // Internal
+		void DrawFramePacket(const FrameCamera& frame, const FramePacket& packet, Mat4& view); // Internal
 		void ConstructFBO(Vec2 pos, Vec2 size) override;
+		bool CanDrawToWindow() const override;
+
+		/**
+		* Sets how sprites are drawn. In the batched and instanced modes consecutive sprites are only drawn when the
+		* texture changes (or something that isn't a sprite is drawn), so the draw order stays the same.
+		*
+		* @param mode[in] - The new mode
+		*/
+		GLIB_API void SetSpriteRenderMode(SpriteRenderMode mode);
+
+		/**
+		* @returns How sprites are currently drawn
+		*/
+		GLIB_API SpriteRenderMode GetSpriteRenderMode() const;
+
+		/**
+		* Enables or disables sprite batching. Same as SetSpriteRenderMode with SpriteRenderMode::BATCHED or SpriteRenderMode::DEFAULT.
+		*
+		* @param enabled[in] - Wether to batch sprites
+		*/
+		GLIB_API void SetBatching(bool enabled);
+
+		/**
+		* @returns Wether sprites are drawn in SpriteRenderMode::BATCHED
+		*/
+		GLIB_API bool IsBatching() const;
+
+		/**
+		* @returns The sprite batch used in SpriteRenderMode::BATCHED (e.g. for reading draw call stats)
+		*/
+		GLIB_API SpriteBatch* GetSpriteBatch();
+
+		/**
+		* @returns The sprite instancer used in SpriteRenderMode::INSTANCED (e.g. for reading draw call stats)
+		*/
+		GLIB_API SpriteInstancer* GetSpriteInstancer();
+
+		/**
+		* Toggles sorting the drawables by layer, shader and texture before drawing them (see RenderQueue).
+		* This makes sprite batches longer, but drawables on the same layer are only kept in order when they share
+		* a shader and texture, so overlapping drawables that have to stay in order should be put on different layers.
+		* Off by default, which draws everything in the order it was added to the camera.
+		*
+		* @param toggle[in] - Whether to sort
+		*/
+		GLIB_API void SetRenderQueue(bool toggle);
+
+		/**
+		* @returns Whether the drawables are sorted before drawing
+		*/
+		GLIB_API bool IsRenderQueue() const;
+
+		/**
+		* Sets how many worker threads build the vertices of batched sprites (SpriteRenderMode::BATCHED).
+		* Long runs of sprites are split into chunks and every worker writes its own range of the streaming vertex buffer,
+		* only the draw calls stay on the thread that owns the OpenGL context. The output is the same as without workers.
+		* Off by default, which builds everything on the calling thread.
+		*
+		* @param threads[in] - The amount of worker threads (0 to turn them off)
+		*/
+		GLIB_API void SetWorkerThreads(unsigned int threads);
+
+		/**
+		* @returns The amount of worker threads building sprite vertices (0 if turned off)
+		*/
+		GLIB_API unsigned int GetWorkerThreads() const;
+
+		/**
+		* @returns How many sprite transforms were updated by the batched pass and how many outside of it when the last camera was drawn
+		*/
+		GLIB_API const SpriteTransformStats& GetTransformStats() const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "../../DLLDefs.h"
+#include "../../math/Mat4.h"
+#include "../../math/Affine2D.h"
+#include "../../utils/Color.h"
+#include "../Drawable.h"
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace glib
+{
+	class Camera;
+
+	/**
+	* One draw of a frame packet. Everything the renderer needs is copied in, so the drawable can change while the packet is drawn.
+	*/
+	struct FrameItem
+	{
+		uint8_t kind; // GLIB_DRAWABLE_SPRITE or GLIB_DRAWABLE_TEXT
+		unsigned int texture; // OpenGL texture id
+		Affine2D transform; // Camera scroll already applied. Sprites: unit square to quad. Text: moves the glyph vertices
+		Color color;
+		Vec2 uvCoord; // Sprites only
+		Vec2 uvSize; // Sprites only
+		size_t firstVertex; // Text only, index into FramePacket::textVertices (4 floats per vertex)
+		size_t vertexCount; // Text only
+	};
+
+	/**
+	* The state of one camera in a frame packet and the range of its items.
+	*/
+	struct FrameCamera
+	{
+		Camera* camera; // Only used as an identifier (e.g. for PipelineElement::IsExcludedFromCamera), never read while drawing
+		Mat4 view;
+		size_t firstItem;
+		size_t itemCount;
+		bool retained = false; // The camera is retained and its signature could be taken (see Camera::SetRetained)
+		uint64_t signature = 0; // Taken on the update thread, so the render thread never reads the camera
+	};
+
+	/**
+	* Everything needed to draw one frame, built on the update thread and drawn on the render thread (see SceneManager::SetRenderThread).
+	* Only sprites and texts are flattened into packets, other drawables are counted in skipped.
+	*/
+	struct FramePacket
+	{
+		std::vector<FrameCamera> cameras;
+		std::vector<FrameItem> items;
+		std::vector<float> textVertices; // x, y, u, v
+		unsigned int skipped = 0;
+
+		// Keeps the capacity, so a packet that is reused every frame stops allocating
+		void Clear()
+		{
+			cameras.clear();
+			items.clear();
+			textVertices.clear();
+			skipped = 0;
+		}
+	};
+}
\ No newline at end of file
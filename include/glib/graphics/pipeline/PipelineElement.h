@@ -8,6 +8,7 @@
 namespace glib
 {
 	class Window;
+	class Framebuffer;
 
 	struct PipelineData
 	{
@@ -26,8 +27,45 @@ namespace glib
 	public:
 		Vec2 viewportPos;
 		Vec2 viewportSize;
+		float pipelineScale = 1.0f; // The render scale of the pipeline, set before every flush like the viewport
 		uint8_t type;
 		std::vector<Camera*> m_ExcludedCameras;
+		bool fused = false; // Drawn by a FusedEffect earlier in the pipeline, so the pipeline skips it
+		bool toWindow = false; // Set by the pipeline before every flush, see CanDrawToWindow
+		unsigned int frame = 0; // Counts the flushes of the pipeline, set before every flush like the viewport
+	private:
+		float m_RenderScale = 1.0f;
+	protected:
+		Vec2 m_TargetSize; // The full size of the output, see ResizeTarget
+
+		/**
+		* Keeps the new size for elements that draw into targets of the window's render target pool.
+		* The pool reallocates its targets once the new size is first acquired, so nothing else needs to be resized.
+		*
+		* @param size[in] - The new full size (usually the window size)
+		*/
+		GLIB_API void ResizeTarget(const Vec2& size);
+
+		/**
+		* Binds what Downstream draws into: the window viewport if toWindow is set, otherwise a cleared target
+		* of the window's render target pool with the viewport covering it.
+		*
+		* @param wnd[in] - The window of the pipeline
+		* @param size[in] - The size of the target (usually GetRenderSize)
+		* @returns The target, nullptr if the output goes straight into the window
+		*/
+		GLIB_API Framebuffer* BindOutput(Window* wnd, const Vec2& size);
+
+		/**
+		* Unbinds the target of BindOutput and gives the input back to the render target pool,
+		* since it has been drawn and the next element can reuse it.
+		*
+		* @param wnd[in] - The window of the pipeline
+		* @param target[in] - The target returned by BindOutput
+		* @param data[in] - The input of Downstream
+		* @returns The output for the next element
+		*/
+		GLIB_API const PipelineData FinishOutput(Window* wnd, Framebuffer* target, const PipelineData& data);
 	public:
 		virtual ~PipelineElement();
 
@@ -35,6 +73,33 @@ namespace glib
 		GLIB_API void RemoveExcludedCamera(Camera* camera);
 		GLIB_API bool IsExcludedFromCamera(Camera* camera);
 
+		/**
+		* Renders the output of the element at a fraction of the window size (e.g. 0.5 for half resolution).
+		* It's multiplied with the render scale of the pipeline, the window renderer scales the result up to the viewport.
+		*
+		* @param scale[in] - The scale (1 by default)
+		*/
+		GLIB_API void SetRenderScale(float scale);
+
+		/**
+		* @returns The render scale of the element
+		*/
+		GLIB_API float GetRenderScale() const;
+
+		/**
+		* @param size[in] - The full size (usually the window size)
+		* @returns The size to render at after applying the render scales, at least one pixel
+		*/
+		GLIB_API Vec2 GetRenderSize(const Vec2& size) const;
+
+		/**
+		* The last element before the WindowRenderer may draw into the window itself (toWindow), which saves the
+		* WindowRenderer a fullscreen copy. It then returns 0 as the texture. Elements that support it return true.
+		*
+		* @returns Whether the element can draw into the window this frame
+		*/
+		GLIB_API virtual bool CanDrawToWindow() const;
+
 		virtual void Construct(Window* wnd) = 0;
 		virtual const PipelineData Downstream(const PipelineData data) = 0;
 	};
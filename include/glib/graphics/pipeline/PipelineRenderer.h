@@ -18,7 +18,9 @@ namespace glib
 		Shader* m_Shd;
 		unsigned int m_VAO;
 		unsigned int m_VBO;
-		Framebuffer* m_FB;
+		Framebuffer* m_FB; // Only allocated if m_PooledTarget is false
+		bool m_PooledTarget; // Draws into a target of Window::GetRenderTargetPool instead of owning m_FB
+		bool m_SharedShader; // Built-in code, other elements with the same code get the same m_Shd (see Window::LoadSharedShader)
 		Vec2 m_Size;
 		Vec2 m_Pos;
 		RendererListener* m_L;
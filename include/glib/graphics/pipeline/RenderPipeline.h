@@ -1,20 +1,75 @@
 #pragma once
 
 #include <vector>
+#include <unordered_map>
+#include <cstdint>
 
 #include "../../DLLDefs.h"
 #include "../camera/Camera.h"
 #include "PipelineElement.h"
+#include "FramePacket.h"
 
 namespace glib
 {
 	class Window;
 
+	/**
+	* The time one pipeline element took for one camera.
+	*/
+	struct GLIB_API PipelineElementStats
+	{
+		Camera* camera = nullptr; // nullptr for elements that don't run per camera (e.g. the 3D renderer)
+		PipelineElement* element = nullptr;
+		double cpuTime = 0.0; // Milliseconds spent in Downstream
+		double gpuTime = 0.0; // Milliseconds the GPU spent on the commands of Downstream (two frames old, 0 until the first result arrived)
+	};
+
+	struct GLIB_API RenderPipelineStats
+	{
+		std::vector<PipelineElementStats> elements; // In the order they ran
+		double cpuTime = 0.0; // Sum of all elements
+		double gpuTime = 0.0; // Sum of all elements
+	};
+
 	class RenderPipeline
 	{
 	protected:
 		std::vector<PipelineElement*> m_Elements;
 		Window* m_Wnd;
+	private:
+		bool m_GPUTiming;
+		mutable RenderPipelineStats m_Stats;
+		mutable unsigned int m_Frame;
+		// GL_TIME_ELAPSED queries per Downstream call, one set per frame parity so a result is only read two frames later
+		mutable std::vector<unsigned int> m_Queries[2];
+		mutable std::vector<PipelineElementStats> m_QueryTargets[2];
+		mutable float m_RenderScale;
+		// Dynamic resolution (see SetDynamicResolution), the controller runs at the end of every Flush
+		double m_TargetGPUTime;
+		float m_MinRenderScale;
+		float m_MaxRenderScale;
+		mutable double m_SmoothedGPUTime;
+		mutable unsigned int m_NextScaleFrame;
+		mutable PipelineElement* m_DirectElement; // Draws into the window this frame (see PipelineElement::CanDrawToWindow)
+
+		// The cached output of a retained camera (see Camera::SetRetained), held in the window's render target pool
+		struct RetainedLayer
+		{
+			uint64_t signature;
+			unsigned int texture;
+			Vec2 viewportSize;
+			float renderScale;
+			unsigned int frame; // The last frame the camera was flushed, EndStats drops the layers of cameras that weren't
+		};
+		mutable std::unordered_map<Camera*, RetainedLayer> m_Layers;
+	private:
+		void UpdateRenderScale() const; // Internal
+	protected:
+		void UpdateViewports() const; // Internal
+		void BeginStats() const; // Internal (call at the start of Flush)
+		const PipelineData RunElement(PipelineElement* element, Camera* camera, const PipelineData& data) const; // Internal (Downstream with timing)
+		void EndStats() const; // Internal (call at the end of Flush, releases the layers of cameras that weren't flushed)
+		void FlushCamera(Camera* camera, PipelineData data, bool retained, uint64_t signature) const; // Internal (runs the elements for one camera, only the composite if its retained output is still valid)
 	public:
 		GLIB_API RenderPipeline(Window* wnd);
 		GLIB_API virtual ~RenderPipeline();
@@ -22,8 +77,60 @@ namespace glib
 		GLIB_API virtual void Update(float delta);
 
 		GLIB_API virtual void Flush(const std::vector<Camera*>& cameras) const;
+
+		/**
+		* Draws a frame packet instead of the live cameras (used by the render thread, see SceneManager::SetRenderThread).
+		* The elements get the camera in PipelineData::ptr as usual, the FrameCamera in ptr2 and the packet in ptr3.
+		*
+		* @param packet[in] - The packet to draw
+		*/
+		GLIB_API virtual void Flush(const FramePacket& packet) const;
 		GLIB_API virtual void AddElement(PipelineElement* element);
 		GLIB_API virtual void RemoveElement(PipelineElement* element);
 		GLIB_API virtual PipelineElement* GetElementByType(uint8_t type) const;
+
+		/**
+		* Returns the CPU and GPU time of every element for every camera of the last Flush.
+		* GPU times come from timer queries that are read two frames later and only if they are already available, so reading them never stalls.
+		*
+		* @returns The stats of the last Flush
+		*/
+		GLIB_API const RenderPipelineStats& GetStats() const;
+
+		/**
+		* Toggles the GPU timer queries. On by default, CPU times are always measured.
+		*
+		* @param toggle[in] - Whether to measure GPU times
+		*/
+		GLIB_API void SetGPUTiming(bool toggle);
+
+		/**
+		* @returns Whether GPU times are measured
+		*/
+		GLIB_API bool IsGPUTiming() const;
+
+		/**
+		* Scales the resolution every element renders at (see PipelineElement::SetRenderScale).
+		* With dynamic resolution this is where the controller starts from.
+		*
+		* @param scale[in] - The scale (1 by default)
+		*/
+		GLIB_API void SetRenderScale(float scale);
+
+		/**
+		* @returns The render scale of the pipeline, adjusted by the controller if dynamic resolution is on
+		*/
+		GLIB_API float GetRenderScale() const;
+
+		/**
+		* Adjusts the render scale after every frame, so the GPU time of the pipeline (see GetStats) approaches the target.
+		* The scale moves in steps of 0.05 and waits for the new step to be measured, so targets aren't reallocated every frame.
+		* Needs GPU timing.
+		*
+		* @param targetGPUTime[in] - The GPU time per frame in milliseconds, 0 turns the controller off
+		* @param minScale[in] - The lowest render scale
+		* @param maxScale[in] - The highest render scale
+		*/
+		GLIB_API void SetDynamicResolution(double targetGPUTime, float minScale = 0.5f, float maxScale = 1.0f);
 	};
 }
\ No newline at end of file
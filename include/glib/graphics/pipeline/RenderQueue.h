@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../../DLLDefs.h"
+#include "../Drawable.h"
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace glib
+{
+	/**
+	* A drawable together with the key it is sorted by.
+	*/
+	struct RenderItem
+	{
+		uint64_t key;
+		Drawable* drawable;
+	};
+
+	class RenderQueueImpl;
+
+	/**
+	* Sorts drawables by a 64 bit key so that drawables sharing a shader and texture end up next to each other.
+	* The sort is a stable radix sort, so drawables with the same key keep the order they were pushed in.
+	*/
+	class RenderQueue
+	{
+	private:
+		RenderQueueImpl* impl;
+	public:
+		GLIB_API RenderQueue();
+		GLIB_API ~RenderQueue();
+
+		/**
+		* Builds a sort key. From most to least significant: layer (16 bits), blend mode (4 bits), shader (12 bits), texture (32 bits).
+		*
+		* @param layer[in] - The layer (lower layers are drawn first)
+		* @param blend[in] - The blend mode
+		* @param shader[in] - The shader (or the kind of drawable, which decides the shader)
+		* @param texture[in] - The OpenGL texture id
+		*/
+		GLIB_API static uint64_t MakeKey(int layer, unsigned int blend, unsigned int shader, unsigned int texture);
+
+		GLIB_API void Clear();
+		GLIB_API void Push(uint64_t key, Drawable* drawable);
+		GLIB_API void Sort();
+		GLIB_API const std::vector<RenderItem>& GetItems() const;
+		GLIB_API size_t GetSize() const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "../../DLLDefs.h"
+#include "../../math/Vec2.h"
+#include "../../utils/Color.h"
+#include "../Shader.h"
+
+#include <cstddef>
+
+namespace glib
+{
+	/**
+	* A single vertex of a batched quad (already transformed into world space).
+	*/
+	struct BatchVertex
+	{
+		float x;
+		float y;
+		float u;
+		float v;
+		Color color;
+	};
+
+	class SpriteBatchImpl;
+
+	/**
+	* Collects transformed quads into one streaming vertex buffer and draws them with as few draw calls as possible.
+	* A flush only happens when the texture or shader changes, the buffer is full or Flush is called.
+	*/
+	class SpriteBatch
+	{
+	private:
+		SpriteBatchImpl* impl;
+	public:
+		GLIB_API SpriteBatch(size_t maxQuads = 4096);
+		GLIB_API ~SpriteBatch();
+
+		/**
+		* Sets the shader used for the following quads. Flushes if it differs from the current one.
+		*
+		* @param shader[in] - The shader to draw with
+		*/
+		GLIB_API void SetShader(Shader* shader);
+
+		/**
+		* Adds a quad to the batch. Flushes first if the texture differs from the current one.
+		*
+		* @param texture[in] - The OpenGL texture id (0 for none)
+		* @param vertices[in] - The 4 corners of the quad in the order: top left, top right, bottom right, bottom left
+		*/
+		GLIB_API void Submit(unsigned int texture, const BatchVertex vertices[4]);
+
+		/**
+		* Draws all pending quads.
+		*/
+		GLIB_API void Flush();
+
+		/**
+		* Reserves room for quads directly in the streaming vertex buffer, so they can be written without the batch (e.g. from worker threads).
+		* Pending quads are flushed first. Nothing else may be submitted until DrawMapped is called.
+		*
+		* @param quads[in] - The amount of quads (at most GetCapacity())
+		* @returns 4 vertices per quad in the same order as Submit, or nullptr if the buffer couldn't be mapped
+		*/
+		GLIB_API BatchVertex* Map(size_t quads);
+
+		/**
+		* Draws the quads written into the last Map call, with one draw call per run of quads sharing a texture.
+		*
+		* @param textures[in] - The OpenGL texture id of every quad
+		* @param quads[in] - The amount of quads (the same as passed to Map)
+		*/
+		GLIB_API void DrawMapped(const unsigned int* textures, size_t quads);
+
+		/**
+		* @returns The most quads a single draw call (or Map) can hold
+		*/
+		GLIB_API size_t GetCapacity() const;
+
+		/**
+		* Resets the draw call and quad counters. Usually called once per frame.
+		*/
+		GLIB_API void ResetStats();
+
+		/**
+		* @returns the amount of draw calls issued since the last ResetStats call
+		*/
+		GLIB_API unsigned int GetDrawCalls() const;
+
+		/**
+		* @returns the amount of quads drawn since the last ResetStats call
+		*/
+		GLIB_API unsigned int GetQuadCount() const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../../DLLDefs.h"
+#include "../../utils/Color.h"
+#include "../Shader.h"
+
+#include <cstddef>
+
+#define GLIB_SPRITE_FLIP_X 0x1
+#define GLIB_SPRITE_FLIP_Y 0x2
+
+namespace glib
+{
+	/**
+	* The per-sprite data of an instanced draw. The model matrix is built from it in the vertex shader.
+	*/
+	struct SpriteInstance
+	{
+		float x; // Top left position (camera scroll already applied)
+		float y;
+		float width; // Size with scale applied
+		float height;
+		float offsetX;
+		float offsetY;
+		float rotation; // In degrees
+		float flags; // GLIB_SPRITE_FLIP_X | GLIB_SPRITE_FLIP_Y
+		float uvX;
+		float uvY;
+		float uvWidth;
+		float uvHeight;
+		Color color;
+	};
+
+	class SpriteInstancerImpl;
+
+	/**
+	* Draws consecutive sprites sharing a texture with one instanced draw call on a unit quad.
+	*/
+	class SpriteInstancer
+	{
+	private:
+		SpriteInstancerImpl* impl;
+	public:
+		/**
+		* @param quadVBO[in] - A vertex buffer holding the 6 vertices (vec3 pos, vec2 uv) of the unit quad
+		* @param maxInstances[in] - The amount of instances after which a flush is forced
+		*/
+		GLIB_API SpriteInstancer(unsigned int quadVBO, size_t maxInstances = 8192);
+		GLIB_API ~SpriteInstancer();
+
+		/**
+		* Sets the shader used for the following instances. Flushes if it differs from the current one.
+		*
+		* @param shader[in] - The shader to draw with
+		*/
+		GLIB_API void SetShader(Shader* shader);
+
+		/**
+		* Adds a sprite instance. Flushes first if the texture differs from the current one.
+		*
+		* @param texture[in] - The OpenGL texture id (0 for none)
+		* @param instance[in] - The instance data
+		*/
+		GLIB_API void Submit(unsigned int texture, const SpriteInstance& instance);
+
+		/**
+		* Draws all pending instances.
+		*/
+		GLIB_API void Flush();
+
+		/**
+		* Resets the draw call and instance counters. Usually called once per frame.
+		*/
+		GLIB_API void ResetStats();
+
+		/**
+		* @returns the amount of draw calls issued since the last ResetStats call
+		*/
+		GLIB_API unsigned int GetDrawCalls() const;
+
+		/**
+		* @returns the amount of instances drawn since the last ResetStats call
+		*/
+		GLIB_API unsigned int GetInstanceCount() const;
+	};
+}
\ No newline at end of file
@@ -13,13 +13,25 @@ namespace glib
 	class WindowRenderer : public PipelineElement
 	{
 	private:
+		Window* m_Wnd;
 		Shader* m_Shd;
 		unsigned int m_VAO;
 		unsigned int m_VBO;
+		bool m_Blit;
+		unsigned int m_LastFrame;
 	public:
 		GLIB_API WindowRenderer();
 		~WindowRenderer();
 
+		/**
+		* The first camera of a frame is copied into the cleared window with glBlitFramebuffer instead of a blended
+		* fullscreen quad. Pipelines that draw into the window before the cameras (e.g. RenderPipeline3D) turn it off.
+		* On by default.
+		*
+		* @param toggle[in] - Whether the first camera may be blitted
+		*/
+		GLIB_API void SetBlit(bool toggle);
+
 		void Construct(Window* wnd);
 		const PipelineData Downstream(const PipelineData data);
 	};
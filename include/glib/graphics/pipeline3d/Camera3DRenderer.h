@@ -3,11 +3,20 @@
 #include "../pipeline/PipelineRenderer.h"
 
 #define GLIB_PE_CAMERA_RENDERER_3D 0x100
+#define GLIB_MESH_TEXTURE_UNIFORMS 8 // Texture uniforms per type (e.g. glib_texture_diffuse1..8) that are looked up ahead of time
 
 namespace glib
 {
 	class Camera3DRenderer : public PipelineRenderer
 	{
+	private:
+		UniformHandle m_ViewUniform;
+		UniformHandle m_ModelUniform;
+		UniformHandle m_ColorUniform;
+		UniformHandle m_UVPosUniform;
+		UniformHandle m_UVSizeUniform;
+		UniformHandle m_UseColorUniform;
+		UniformHandle m_TextureUniforms[4][GLIB_MESH_TEXTURE_UNIFORMS];
 	public:
 		GLIB_API Camera3DRenderer();
 		~Camera3DRenderer() override;
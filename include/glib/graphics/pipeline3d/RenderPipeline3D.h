@@ -25,6 +25,7 @@ namespace glib
 		GLIB_API void Update(float delta) override;
 
 		GLIB_API void Flush(const std::vector<Camera*>& cameras) const override;
+		GLIB_API void AddElement(PipelineElement* element) override;
 		GLIB_API Camera3D* GetCamera();
 	};
 }
\ No newline at end of file
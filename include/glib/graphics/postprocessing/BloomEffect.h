@@ -0,0 +1,47 @@
+#pragma once
+
+#include "../../DLLDefs.h"
+#include "../pipeline/PipelineElement.h"
+#include "../../framebuffer/Framebuffer.h"
+#include "../Shader.h"
+#include "PostProcessing.h"
+
+#define GLIB_PE_EFFECT_BLOOM 0x8
+
+namespace glib
+{
+	/**
+	* Dual filter (Kawase) bloom: a bright pass at half resolution, a chain of downsamples that halve the size each
+	* iteration, upsamples back to half resolution and a composite onto the input.
+	* Every level is a quarter of the previous one, so the cost barely depends on the resolution or the radius.
+	*/
+	class BloomEffect : public PipelineElement
+	{
+	private:
+		void* m_L;
+		Window* m_Wnd;
+		Shader* m_BrightShd;
+		Shader* m_DownShd;
+		Shader* m_UpShd;
+		Shader* m_CompositeShd;
+		unsigned int m_VAO;
+		unsigned int m_VBO;
+		float m_Strength;
+		float m_Threshold;
+		int m_Iterations;
+	private:
+		unsigned int Pass(Shader* shader, unsigned int input, const Vec2& inputSize, const Vec2& size); // Internal (draws input into a pooled target)
+	public:
+		BloomEffect(const BloomParams& params);
+		~BloomEffect();
+
+		GLIB_API void SetStrength(float strength);
+		GLIB_API void SetThreshold(float threshold);
+		GLIB_API void SetIterations(int iterations);
+
+		void Construct(Window* wnd) override;
+		const PipelineData Downstream(const PipelineData data) override;
+		void ConstructFBO(Vec2 pos, Vec2 size);
+		bool CanDrawToWindow() const override;
+	};
+}
\ No newline at end of file
@@ -4,19 +4,17 @@
 #include "../pipeline/PipelineElement.h"
 #include "../../framebuffer/Framebuffer.h"
 #include "../Shader.h"
+#include "EffectStage.h"
 
 #define GLIB_PE_EFFECT_CRT 0x3
 
 namespace glib
 {
-	class CRTEffect : public PipelineElement
+	class CRTEffect : public PipelineElement, public EffectStage
 	{
 	private:
-		Framebuffer* m_FB;
 		void* m_L;
 		Window* m_Wnd;
-		Vec2 m_Pos;
-		Vec2 m_Size;
 		Shader* m_Shd;
 		unsigned int m_VAO;
 		unsigned int m_VBO;
@@ -27,5 +25,10 @@ namespace glib
 		void Construct(Window* wnd) override;
 		const PipelineData Downstream(const PipelineData data) override;
 		void ConstructFBO(Vec2 pos, Vec2 size);
+		bool CanDrawToWindow() const override;
+
+		std::string GetStageCode() const override;
+		bool IsNeighbourhoodStage() const override;
+		void ApplyStageUniforms(Shader* shader) override;
 	};
 }
\ No newline at end of file
@@ -5,19 +5,17 @@
 #include "../../framebuffer/Framebuffer.h"
 #include "../Shader.h"
 #include "PostProcessing.h"
+#include "EffectStage.h"
 
 #define GLIB_PE_EFFECT_CHROMATIC 0x4
 
 namespace glib
 {
-	class ChromaticEffect : public PipelineElement
+	class ChromaticEffect : public PipelineElement, public EffectStage
 	{
 	private:
-		Framebuffer* m_FB;
 		void* m_L;
 		Window* m_Wnd;
-		Vec2 m_Pos;
-		Vec2 m_Size;
 		Shader* m_Shd;
 		unsigned int m_VAO;
 		unsigned int m_VBO;
@@ -31,5 +29,10 @@ namespace glib
 		void Construct(Window* wnd) override;
 		const PipelineData Downstream(const PipelineData data) override;
 		void ConstructFBO(Vec2 pos, Vec2 size);
+		bool CanDrawToWindow() const override;
+
+		std::string GetStageCode() const override;
+		bool IsNeighbourhoodStage() const override;
+		void ApplyStageUniforms(Shader* shader) override;
 	};
 }
\ No newline at end of file
@@ -1,14 +1,24 @@
 #pragma once
 
 #include "../pipeline/PipelineRenderer.h"
+#include "EffectStage.h"
 #include <string>
 
 #define GLIB_PE_CUSTOM_SHADER 0x6
 
 namespace glib
 {
-	class CustomShader : public PipelineRenderer
+	/**
+	* Runs custom fragment code on the output of the previous element.
+	*
+	* The code is either a full fragment shader (texture unit 0, glib_uv and texSize), or stage code
+	* defining vec4 effect(vec2 uv, vec4 color) (see EffectStage), which can be fused with its neighbours.
+	* Stage code that reads glib_input can only start a fused pass.
+	*/
+	class CustomShader : public PipelineRenderer, public EffectStage
 	{
+	private:
+		std::string m_StageCode; // Empty if the code is a full fragment shader
 	public:
 		CustomShader(const std::string& fragmentCode);
 		~CustomShader() override;
@@ -16,7 +26,18 @@ namespace glib
 		void Construct(Window* wnd) override;
 		const PipelineData Downstream(const PipelineData data) override;
 		void ConstructFBO(Vec2 pos, Vec2 size) override;
+		bool CanDrawToWindow() const override;
 
+		std::string GetStageCode() const override;
+		bool IsNeighbourhoodStage() const override;
+		void ApplyStageUniforms(Shader* shader) override;
+
+		/**
+		* Custom uniforms are set on this shader. When the effect is fused, they are copied to the shared shader of the pass
+		* every time it's drawn, so the effect looks the same when it draws itself for a camera excluded from the other effects.
+		*
+		* @returns The shader that draws the effect
+		*/
 		GLIB_API Shader* GetShader();
 	};
 }
\ No newline at end of file
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../../DLLDefs.h"
+#include "../Shader.h"
+
+#include <string>
+#include <vector>
+
+namespace glib
+{
+	/**
+	* Implemented by effects that can be fused with their neighbours into a single fullscreen pass (see FusedEffect).
+	*
+	* A stage is GLSL defining vec4 effect(vec2 uv, vec4 color), where color is the output of the previous stage at uv.
+	* Every stage can read glib_input (the input texture of the pass) and glib_tex_size (the size of that texture in pixels).
+	* Uniforms and helper functions of a stage need names that don't clash with other stages (e.g. a prefix).
+	*/
+	class EffectStage
+	{
+	public:
+		virtual ~EffectStage() = default;
+
+		/**
+		* @returns The GLSL of the stage
+		*/
+		virtual std::string GetStageCode() const = 0;
+
+		/**
+		* A stage that samples glib_input anywhere but at uv needs the finished output of the previous effect,
+		* so it can only be the first stage of a pass.
+		*
+		* @returns Whether the stage samples its neighbourhood
+		*/
+		virtual bool IsNeighbourhoodStage() const = 0;
+
+		/**
+		* Sets the uniforms of the stage on the shader that draws it. The shader is already in use.
+		*
+		* @param shader[in] - The shader the stage is part of
+		*/
+		virtual void ApplyStageUniforms(Shader* shader) = 0;
+
+		/**
+		* Called when the stage is drawn by a fused shader instead of its own.
+		*
+		* @param shader[in] - The fused shader (nullptr if the stage draws itself again)
+		*/
+		virtual void SetFusedShader(Shader*) {}
+
+		/**
+		* Generates a fragment shader that runs the stages one after another on every pixel.
+		* The matching vertex shader has to output the texture coordinates as glib_uv.
+		*
+		* @param stages[in] - The GLSL of every stage in order
+		* @returns The fragment shader
+		*/
+		GLIB_API static std::string BuildShader(const std::vector<std::string>& stages);
+	};
+}
\ No newline at end of file
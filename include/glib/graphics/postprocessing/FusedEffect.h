@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../../DLLDefs.h"
+#include "../pipeline/PipelineElement.h"
+#include "../Shader.h"
+#include "EffectStage.h"
+
+#include <vector>
+
+#define GLIB_PE_FUSED_EFFECT 0x7
+
+namespace glib
+{
+	/**
+	* Draws consecutive effects in a single fullscreen pass with a shader generated from their stage code.
+	* The effects stay in the pipeline (e.g. for GetElementByType), but are skipped while this one draws them.
+	* The pass renders at the render scale of the first effect.
+	*/
+	class FusedEffect : public PipelineElement
+	{
+	private:
+		void* m_L;
+		Window* m_Wnd;
+		Shader* m_Shd;
+		unsigned int m_VAO;
+		unsigned int m_VBO;
+		std::vector<PipelineElement*> m_Elements;
+		std::vector<EffectStage*> m_Stages;
+	public:
+		/**
+		* @param elements[in] - The effects in pipeline order, all of them have to implement EffectStage
+		*/
+		FusedEffect(const std::vector<PipelineElement*>& elements);
+		~FusedEffect();
+
+		void Construct(Window* wnd) override;
+		const PipelineData Downstream(const PipelineData data) override;
+		void ConstructFBO(Vec2 pos, Vec2 size);
+		bool CanDrawToWindow() const override;
+	};
+}
\ No newline at end of file
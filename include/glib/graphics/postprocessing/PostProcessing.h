@@ -15,11 +15,16 @@
 namespace glib
 {
 
-	struct ShaderEffectParams {};
+	struct ShaderEffectParams
+	{
+		float renderScale = 1.0f; // Fraction of the window size the effect renders at (see PipelineElement::SetRenderScale)
+	};
 
 	struct BloomParams : ShaderEffectParams
 	{
-		float strength;
+		float strength = 1.0f; // How much of the bloom is added to the image
+		float threshold = 0.8f; // Brightness (max of r, g, b) above which pixels start to glow
+		int iterations = 5; // Steps of the mip chain, each one doubles the radius. It starts at half resolution
 	};
 
 	struct SpeedLinesParams : ShaderEffectParams
@@ -46,11 +51,21 @@ namespace glib
 			RenderPipeline* m_Pipeline;
 			bool m_Built;
 			Window* m_Wnd;
+			std::vector<PipelineElement*> m_Effects; // Added to the pipeline by Build
+			bool m_Fusion;
 		public:
 			Builder(Window* wnd);
 			GLIB_API ~Builder();
 
 			GLIB_API Builder& AddEffect(uint64_t effect, const ShaderEffectParams& params);
+
+			/**
+			* Fusion draws consecutive effects in one pass (see FusedEffect). An effect that samples
+			* around its pixel (CRT, chromatic aberration) can only start a pass. Enabled by default.
+			*
+			* @param toggle[in] - Whether Build fuses effects
+			*/
+			GLIB_API Builder& SetFusion(bool toggle);
 			GLIB_API RenderPipeline* Build();
 		};
 	public:
@@ -5,19 +5,17 @@
 #include "../../framebuffer/Framebuffer.h"
 #include "../Shader.h"
 #include "../../utils/Color.h"
+#include "EffectStage.h"
 
 #define GLIB_PE_EFFECT_SPEED_LINES 0x5
 
 namespace glib
 {
-	class SpeedLinesEffect : public PipelineElement
+	class SpeedLinesEffect : public PipelineElement, public EffectStage
 	{
 	private:
-		Framebuffer* m_FB;
 		void* m_L;
 		Window* m_Wnd;
-		Vec2 m_Pos;
-		Vec2 m_Size;
 		Shader* m_Shd;
 		unsigned int m_VAO;
 		unsigned int m_VBO;
@@ -35,5 +33,10 @@ namespace glib
 		void Construct(Window* wnd) override;
 		const PipelineData Downstream(const PipelineData data) override;
 		void ConstructFBO(Vec2 pos, Vec2 size);
+		bool CanDrawToWindow() const override;
+
+		std::string GetStageCode() const override;
+		bool IsNeighbourhoodStage() const override;
+		void ApplyStageUniforms(Shader* shader) override;
 	};
 }
\ No newline at end of file
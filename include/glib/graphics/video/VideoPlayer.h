@@ -33,5 +33,6 @@ namespace glib
 
 		GLIB_API void Draw() override; // Actually does something
 		GLIB_API void Update(float delta) override;
+		GLIB_API bool GetBounds(const Vec2& cameraPos, float zoom, Rect& bounds) override;
 	};
 }
\ No newline at end of file
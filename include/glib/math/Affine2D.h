@@ -0,0 +1,278 @@
+#pragma once
+
+#include "../DLLDefs.h"
+#include "Vec2.h"
+#include "Rect.h"
+#include "Mat4.h"
+#include "VecBatch.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define GLIB_AFFINE_FLIP_X 0x1
+#define GLIB_AFFINE_FLIP_Y 0x2
+
+namespace glib
+{
+	/**
+	* A 2D affine transform (a 2x3 matrix). Enough for everything the 2D renderer does, at a fraction of the cost of a Mat4.
+	* x' = a * x + c * y + tx
+	* y' = b * x + d * y + ty
+	*/
+	struct Affine2D
+	{
+		float a, b; // First column (where the x axis ends up)
+		float c, d; // Second column (where the y axis ends up)
+		float tx, ty;
+
+		constexpr Affine2D() : a(1.0f), b(0.0f), c(0.0f), d(1.0f), tx(0.0f), ty(0.0f) {}
+		constexpr Affine2D(float a, float b, float c, float d, float tx, float ty) : a(a), b(b), c(c), d(d), tx(tx), ty(ty) {}
+
+		constexpr Vec2 Apply(const Vec2& p) const
+		{
+			return Vec2(a * p.x + c * p.y + tx, b * p.x + d * p.y + ty);
+		}
+
+		// Applies other first, then this
+		constexpr Affine2D operator*(const Affine2D& other) const
+		{
+			return Affine2D(a * other.a + c * other.b, b * other.a + d * other.b,
+				a * other.c + c * other.d, b * other.c + d * other.d,
+				a * other.tx + c * other.ty + tx, b * other.tx + d * other.ty + ty);
+		}
+
+		Mat4 ToMat4() const
+		{
+			Mat4 m;
+			float* data = (float*)m.GetPtr();
+			data[0] = a;
+			data[1] = b;
+			data[4] = c;
+			data[5] = d;
+			data[12] = tx;
+			data[13] = ty;
+			return m;
+		}
+
+		/**
+		* @returns The axis aligned bounds of the transformed unit square (0, 0) - (1, 1)
+		*/
+		Rect GetQuadBounds() const
+		{
+			float minX = tx + (a < 0.0f ? a : 0.0f) + (c < 0.0f ? c : 0.0f);
+			float minY = ty + (b < 0.0f ? b : 0.0f) + (d < 0.0f ? d : 0.0f);
+			return Rect(minX, minY, std::fabs(a) + std::fabs(c), std::fabs(b) + std::fabs(d));
+		}
+	};
+
+	/**
+	* Builds the transform that maps the unit square onto a sprite in one step (instead of composing translations, a rotation and a scale).
+	* The scaled sprite stays centered on the unscaled one, the offset moves it in its rotated space and a flip mirrors the square.
+	*
+	* @param pos[in] - The top left corner of the unscaled sprite (camera scroll already applied)
+	* @param size[in] - The unscaled size
+	* @param scale[in] - The scale
+	* @param offset[in] - Moves the sprite without moving the pivot
+	* @param pivot[in] - What to rotate around, relative to the scaled size (0.5, 0.5 is the center)
+	* @param rotation[in] - In degrees
+	* @param flip[in] - GLIB_AFFINE_FLIP_X | GLIB_AFFINE_FLIP_Y
+	*/
+	inline Affine2D MakeSpriteTransform(const Vec2& pos, const Vec2& size, const Vec2& scale, const Vec2& offset, const Vec2& pivot, float rotation, uint8_t flip = 0)
+	{
+		float rad = rotation * 0.017453292519943295f;
+		float cs = std::cos(rad);
+		float sn = std::sin(rad);
+
+		float w = size.x * scale.x;
+		float h = size.y * scale.y;
+		float px = pivot.x * w;
+		float py = pivot.y * h;
+		float ux = offset.x - px;
+		float uy = offset.y - py;
+
+		Affine2D t(cs * w, sn * w, -sn * h, cs * h,
+			pos.x - (w - size.x) * 0.5f + px + cs * ux - sn * uy,
+			pos.y - (h - size.y) * 0.5f + py + sn * ux + cs * uy);
+
+		if (flip & GLIB_AFFINE_FLIP_X)
+		{
+			t.tx += t.a;
+			t.ty += t.b;
+			t.a = -t.a;
+			t.b = -t.b;
+		}
+		if (flip & GLIB_AFFINE_FLIP_Y)
+		{
+			t.tx += t.c;
+			t.ty += t.d;
+			t.c = -t.c;
+			t.d = -t.d;
+		}
+
+		return t;
+	}
+
+	/**
+	* The inputs of MakeSpriteTransform for many sprites, stored as structure of arrays so BatchSpriteTransforms can vectorize.
+	* The vectors are kept between Clear calls, so refilling it every frame doesn't allocate.
+	*/
+	struct SpriteTransformBatch
+	{
+		std::vector<float> posX, posY;
+		std::vector<float> sizeX, sizeY;
+		std::vector<float> scaleX, scaleY;
+		std::vector<float> offsetX, offsetY;
+		std::vector<float> rotation;
+		std::vector<uint8_t> flip;
+		Vec2 pivot = Vec2(0.5f, 0.5f); // Shared by all sprites
+
+		void Push(const Vec2& pos, const Vec2& size, const Vec2& scale, const Vec2& offset, float rot, uint8_t flags)
+		{
+			posX.push_back(pos.x);
+			posY.push_back(pos.y);
+			sizeX.push_back(size.x);
+			sizeY.push_back(size.y);
+			scaleX.push_back(scale.x);
+			scaleY.push_back(scale.y);
+			offsetX.push_back(offset.x);
+			offsetY.push_back(offset.y);
+			rotation.push_back(rot);
+			flip.push_back(flags);
+		}
+
+		void Clear()
+		{
+			posX.clear();
+			posY.clear();
+			sizeX.clear();
+			sizeY.clear();
+			scaleX.clear();
+			scaleY.clear();
+			offsetX.clear();
+			offsetY.clear();
+			rotation.clear();
+			flip.clear();
+		}
+
+		size_t GetCount() const
+		{
+			return posX.size();
+		}
+	};
+
+	/**
+	* MakeSpriteTransform for every sprite of the batch, four sprites at a time where SSE or NEON is available.
+	*
+	* @param batch[in] - The sprites
+	* @param begin[in] - The first sprite
+	* @param end[in] - One past the last sprite
+	* @param out[out] - One transform per sprite, indexed like the batch (so ranges can be filled from different threads)
+	*/
+	inline void BatchSpriteTransforms(const SpriteTransformBatch& batch, size_t begin, size_t end, Affine2D* out)
+	{
+		size_t i = begin;
+
+#if defined(GLIB_SIMD_SSE) || defined(GLIB_SIMD_NEON)
+#if defined(GLIB_SIMD_SSE)
+		typedef __m128 Lane;
+		auto load = [](const float* p) { return _mm_loadu_ps(p); };
+		auto set = [](float v) { return _mm_set1_ps(v); };
+		auto add = [](Lane l, Lane r) { return _mm_add_ps(l, r); };
+		auto sub = [](Lane l, Lane r) { return _mm_sub_ps(l, r); };
+		auto mul = [](Lane l, Lane r) { return _mm_mul_ps(l, r); };
+		auto store = [](float* p, Lane l) { _mm_storeu_ps(p, l); };
+#else
+		typedef float32x4_t Lane;
+		auto load = [](const float* p) { return vld1q_f32(p); };
+		auto set = [](float v) { return vdupq_n_f32(v); };
+		auto add = [](Lane l, Lane r) { return vaddq_f32(l, r); };
+		auto sub = [](Lane l, Lane r) { return vsubq_f32(l, r); };
+		auto mul = [](Lane l, Lane r) { return vmulq_f32(l, r); };
+		auto store = [](float* p, Lane l) { vst1q_f32(p, l); };
+#endif
+		Lane half = set(0.5f);
+		Lane pivotX = set(batch.pivot.x);
+		Lane pivotY = set(batch.pivot.y);
+
+		for (; i + 4 <= end; i += 4)
+		{
+			// Sine and cosine stay scalar, everything else runs on four sprites at once
+			float cosines[4], sines[4], signX[4], shiftX[4], signY[4], shiftY[4];
+			for (int k = 0; k < 4; k++)
+			{
+				float rad = batch.rotation[i + k] * 0.017453292519943295f;
+				cosines[k] = std::cos(rad);
+				sines[k] = std::sin(rad);
+				bool fx = (batch.flip[i + k] & GLIB_AFFINE_FLIP_X) != 0;
+				bool fy = (batch.flip[i + k] & GLIB_AFFINE_FLIP_Y) != 0;
+				signX[k] = fx ? -1.0f : 1.0f;
+				shiftX[k] = fx ? 1.0f : 0.0f;
+				signY[k] = fy ? -1.0f : 1.0f;
+				shiftY[k] = fy ? 1.0f : 0.0f;
+			}
+
+			Lane cs = load(cosines);
+			Lane sn = load(sines);
+			Lane sizeX = load(&batch.sizeX[i]);
+			Lane sizeY = load(&batch.sizeY[i]);
+			Lane w = mul(sizeX, load(&batch.scaleX[i]));
+			Lane h = mul(sizeY, load(&batch.scaleY[i]));
+			Lane px = mul(pivotX, w);
+			Lane py = mul(pivotY, h);
+			Lane ux = sub(load(&batch.offsetX[i]), px);
+			Lane uy = sub(load(&batch.offsetY[i]), py);
+
+			Lane a = mul(cs, w);
+			Lane b = mul(sn, w);
+			Lane c = sub(set(0.0f), mul(sn, h));
+			Lane d = mul(cs, h);
+			Lane tx = add(sub(load(&batch.posX[i]), mul(sub(w, sizeX), half)), add(px, sub(mul(cs, ux), mul(sn, uy))));
+			Lane ty = add(sub(load(&batch.posY[i]), mul(sub(h, sizeY), half)), add(py, add(mul(sn, ux), mul(cs, uy))));
+
+			// Flipping mirrors the unit square: the axis is negated and the origin moves to its other end
+			Lane fx = load(shiftX);
+			Lane fy = load(shiftY);
+			tx = add(tx, add(mul(fx, a), mul(fy, c)));
+			ty = add(ty, add(mul(fx, b), mul(fy, d)));
+			Lane sx = load(signX);
+			Lane sy = load(signY);
+			a = mul(a, sx);
+			b = mul(b, sx);
+			c = mul(c, sy);
+			d = mul(d, sy);
+
+			float result[6][4];
+			store(result[0], a);
+			store(result[1], b);
+			store(result[2], c);
+			store(result[3], d);
+			store(result[4], tx);
+			store(result[5], ty);
+
+			for (int k = 0; k < 4; k++)
+			{
+				out[i + k] = Affine2D(result[0][k], result[1][k], result[2][k], result[3][k], result[4][k], result[5][k]);
+			}
+		}
+#endif
+
+		for (; i < end; i++)
+		{
+			out[i] = MakeSpriteTransform(Vec2(batch.posX[i], batch.posY[i]), Vec2(batch.sizeX[i], batch.sizeY[i]), Vec2(batch.scaleX[i], batch.scaleY[i]),
+				Vec2(batch.offsetX[i], batch.offsetY[i]), batch.pivot, batch.rotation[i], batch.flip[i]);
+		}
+	}
+
+	/**
+	* MakeSpriteTransform for every sprite of the batch, four sprites at a time where SSE or NEON is available.
+	*
+	* @param batch[in] - The sprites
+	* @param out[out] - One transform per sprite (needs room for batch.GetCount() transforms)
+	*/
+	inline void BatchSpriteTransforms(const SpriteTransformBatch& batch, Affine2D* out)
+	{
+		BatchSpriteTransforms(batch, 0, batch.GetCount(), out);
+	}
+}
\ No newline at end of file
@@ -4,30 +4,136 @@
 #include "Vec2.h"
 #include "Vec3.h"
 
+#include <cmath>
+
 namespace glib
 {
-	class Mat4Impl;
-
-	class Mat4
+	/**
+	* A column major 4x4 matrix (same layout as OpenGL expects it). It's a plain value, so creating and copying one is free.
+	*/
+	class alignas(16) Mat4
 	{
 	private:
-		Mat4Impl* impl;
+		float m_Data[16];
 	public:
-		GLIB_API Mat4();
-		GLIB_API ~Mat4();
+		Mat4()
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				m_Data[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+			}
+		}
+
+		Mat4(const Mat4& other) = default;
+		Mat4& operator=(const Mat4& other) = default;
+
+		void Translate(const Vec2& vec)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				m_Data[12 + i] += m_Data[i] * vec.x + m_Data[4 + i] * vec.y;
+			}
+		}
+
+		void Scale(const Vec2& vec) // Also flattens the Z-Axis
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				m_Data[i] *= vec.x;
+				m_Data[4 + i] *= vec.y;
+				m_Data[8 + i] = 0.0f;
+			}
+		}
+
+		void Translate(const Vec3& vec)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				m_Data[12 + i] += m_Data[i] * vec.x + m_Data[4 + i] * vec.y + m_Data[8 + i] * vec.z;
+			}
+		}
+
+		void Scale(const Vec3& vec)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				m_Data[i] *= vec.x;
+				m_Data[4 + i] *= vec.y;
+				m_Data[8 + i] *= vec.z;
+			}
+		}
+
+		void Rotate(float deg) // Z-Axis for 2D
+		{
+			float rad = deg * 0.017453292519943295f;
+			float c = std::cos(rad);
+			float s = std::sin(rad);
+
+			for (int i = 0; i < 4; i++)
+			{
+				float x = m_Data[i];
+				float y = m_Data[4 + i];
+				m_Data[i] = x * c + y * s;
+				m_Data[4 + i] = y * c - x * s;
+			}
+		}
+
+		void Rotate(float deg, const Vec3& axis)
+		{
+			float rad = deg * 0.017453292519943295f;
+			float c = std::cos(rad);
+			float s = std::sin(rad);
+
+			float len = std::sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+			float a[3] = { axis.x / len, axis.y / len, axis.z / len };
+			float t[3] = { (1.0f - c) * a[0], (1.0f - c) * a[1], (1.0f - c) * a[2] };
+
+			// Rotation matrix r[column][row]
+			float r[3][3] = {
+				{ c + t[0] * a[0], t[0] * a[1] + s * a[2], t[0] * a[2] - s * a[1] },
+				{ t[1] * a[0] - s * a[2], c + t[1] * a[1], t[1] * a[2] + s * a[0] },
+				{ t[2] * a[0] + s * a[1], t[2] * a[1] - s * a[0], c + t[2] * a[2] }
+			};
+
+			for (int i = 0; i < 4; i++)
+			{
+				float x = m_Data[i];
+				float y = m_Data[4 + i];
+				float z = m_Data[8 + i];
+				m_Data[i] = x * r[0][0] + y * r[0][1] + z * r[0][2];
+				m_Data[4 + i] = x * r[1][0] + y * r[1][1] + z * r[1][2];
+				m_Data[8 + i] = x * r[2][0] + y * r[2][1] + z * r[2][2];
+			}
+		}
+
+		Mat4 operator*(const Mat4& other) const
+		{
+			Mat4 m;
+			for (int col = 0; col < 4; col++)
+			{
+				for (int row = 0; row < 4; row++)
+				{
+					m.m_Data[col * 4 + row] = m_Data[row] * other.m_Data[col * 4] + m_Data[4 + row] * other.m_Data[col * 4 + 1] +
+						m_Data[8 + row] * other.m_Data[col * 4 + 2] + m_Data[12 + row] * other.m_Data[col * 4 + 3];
+				}
+			}
+			return m;
+		}
 
-		GLIB_API void Translate(const Vec2& vec);
-		GLIB_API void Scale(const Vec2& vec);
-		GLIB_API void Translate(const Vec3& vec);
-		GLIB_API void Scale(const Vec3& vec);
-		GLIB_API void Rotate(float deg, const Vec3& axis = Vec3(0.0f, 0.0f, 1.0f)); // Z-Axis for 2D
+		void* GetPtr()
+		{
+			return m_Data;
+		}
 
-		GLIB_API Mat4 operator*(Mat4& other);
-			
-		GLIB_API void* GetPtr();
-		GLIB_API Mat4 Copy();
+		const float* GetData() const
+		{
+			return m_Data;
+		}
 
-		friend class Mat4Impl;
+		Mat4 Copy() const
+		{
+			return *this;
+		}
 	public:
 		GLIB_API static Mat4 Ortho(float left, float right, float bottom, float top);
 		GLIB_API static Mat4 Perspective(float fov, float aspect, float near, float far);
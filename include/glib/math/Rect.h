@@ -16,5 +16,10 @@ namespace glib
 		GLIB_API Rect(float x, float y, float w, float h);
 
 		GLIB_API float Distance(const Rect& other);
+
+		/**
+		* @returns Wether this rectangle and the other one overlap (touching edges count as overlapping)
+		*/
+		GLIB_API bool Overlaps(const Rect& other) const;
 	};
 }
\ No newline at end of file
@@ -2,43 +2,54 @@
 
 #include "../DLLDefs.h"
 
+#include <cmath>
+
 #define GLIB_VEC2_ZERO glib::Vec2(0.0f, 0.0f)
 
 namespace glib
 {
-	class GLIB_API Vec2
+	class Vec2
 	{
 	public:
 		float x;
 		float y;
 	public:
-		Vec2();
-		Vec2(float x, float y);
-
-		Vec2 operator+(const Vec2& other);
-		Vec2 operator+(float v);
-		Vec2 operator-(const Vec2& other);
-		Vec2 operator-(float v);
-		Vec2 operator*(const Vec2& other);
-		Vec2 operator*(float v);
-		Vec2 operator/(const Vec2& other);
-		Vec2 operator/(float v);
-		Vec2 operator^(const Vec2& other);
-		Vec2 operator^(float v);
-
-		void operator+=(const Vec2& other);
-		void operator+=(float v);
-		void operator-=(const Vec2& other);
-		void operator-=(float v);
-		void operator*=(const Vec2& other);
-		void operator*=(float v);
-		void operator/=(const Vec2& other);
-		void operator/=(float v);
-		void operator^=(const Vec2& other);
-		void operator^=(float v);
-
-		Vec2 Normalize();
-
-		float Distance(const Vec2& other);
+		constexpr Vec2() : x(0.0f), y(0.0f) {}
+		constexpr Vec2(float x, float y) : x(x), y(y) {}
+
+		constexpr Vec2 operator+(const Vec2& other) const { return Vec2(x + other.x, y + other.y); }
+		constexpr Vec2 operator+(float v) const { return Vec2(x + v, y + v); }
+		constexpr Vec2 operator-(const Vec2& other) const { return Vec2(x - other.x, y - other.y); }
+		constexpr Vec2 operator-(float v) const { return Vec2(x - v, y - v); }
+		constexpr Vec2 operator*(const Vec2& other) const { return Vec2(x * other.x, y * other.y); }
+		constexpr Vec2 operator*(float v) const { return Vec2(x * v, y * v); }
+		constexpr Vec2 operator/(const Vec2& other) const { return Vec2(x / other.x, y / other.y); }
+		constexpr Vec2 operator/(float v) const { return Vec2(x / v, y / v); }
+		Vec2 operator^(const Vec2& other) const { return Vec2(powf(x, other.x), powf(y, other.y)); }
+		Vec2 operator^(float v) const { return Vec2(powf(x, v), powf(y, v)); }
+
+		constexpr void operator+=(const Vec2& other) { x += other.x; y += other.y; }
+		constexpr void operator+=(float v) { x += v; y += v; }
+		constexpr void operator-=(const Vec2& other) { x -= other.x; y -= other.y; }
+		constexpr void operator-=(float v) { x -= v; y -= v; }
+		constexpr void operator*=(const Vec2& other) { x *= other.x; y *= other.y; }
+		constexpr void operator*=(float v) { x *= v; y *= v; }
+		constexpr void operator/=(const Vec2& other) { x /= other.x; y /= other.y; }
+		constexpr void operator/=(float v) { x /= v; y /= v; }
+		void operator^=(const Vec2& other) { x = powf(x, other.x); y = powf(y, other.y); }
+		void operator^=(float v) { x = powf(x, v); y = powf(y, v); }
+
+		Vec2 Normalize() const
+		{
+			float len = sqrtf(x * x + y * y);
+			return Vec2(x / len, y / len);
+		}
+
+		float Distance(const Vec2& other) const
+		{
+			float dx = other.x - x;
+			float dy = other.y - y;
+			return sqrtf(dx * dx + dy * dy);
+		}
 	};
 }
\ No newline at end of file
@@ -2,45 +2,61 @@
 
 #include "../DLLDefs.h"
 
+#include <cmath>
+
 namespace glib
 {
-	class GLIB_API Vec3
+	class Vec3
 	{
 	public:
 		float x;
 		float y;
 		float z;
 	public:
-		Vec3();
-		Vec3(float x, float y, float z);
-
-		Vec3 operator+(const Vec3& other);
-		Vec3 operator+(float v);
-		Vec3 operator-(const Vec3& other);
-		Vec3 operator-(float v);
-		Vec3 operator*(const Vec3& other);
-		Vec3 operator*(float v);
-		Vec3 operator/(const Vec3& other);
-		Vec3 operator/(float v);
-		Vec3 operator^(const Vec3& other);
-		Vec3 operator^(float v);
-
-		void operator+=(const Vec3& other);
-		void operator+=(float v);
-		void operator-=(const Vec3& other);
-		void operator-=(float v);
-		void operator*=(const Vec3& other);
-		void operator*=(float v);
-		void operator/=(const Vec3& other);
-		void operator/=(float v);
-		void operator^=(const Vec3& other);
-		void operator^=(float v);
-
-		Vec3 operator-();
-
-		Vec3 Normalize();
-		Vec3 Cross(const Vec3& other);
-
-		float Distance(const Vec3& other);
+		constexpr Vec3() : x(0.0f), y(0.0f), z(0.0f) {}
+		constexpr Vec3(float x, float y, float z) : x(x), y(y), z(z) {}
+
+		constexpr Vec3 operator+(const Vec3& other) const { return Vec3(x + other.x, y + other.y, z + other.z); }
+		constexpr Vec3 operator+(float v) const { return Vec3(x + v, y + v, z + v); }
+		constexpr Vec3 operator-(const Vec3& other) const { return Vec3(x - other.x, y - other.y, z - other.z); }
+		constexpr Vec3 operator-(float v) const { return Vec3(x - v, y - v, z - v); }
+		constexpr Vec3 operator*(const Vec3& other) const { return Vec3(x * other.x, y * other.y, z * other.z); }
+		constexpr Vec3 operator*(float v) const { return Vec3(x * v, y * v, z * v); }
+		constexpr Vec3 operator/(const Vec3& other) const { return Vec3(x / other.x, y / other.y, z / other.z); }
+		constexpr Vec3 operator/(float v) const { return Vec3(x / v, y / v, z / v); }
+		Vec3 operator^(const Vec3& other) const { return Vec3(powf(x, other.x), powf(y, other.y), powf(z, other.z)); }
+		Vec3 operator^(float v) const { return Vec3(powf(x, v), powf(y, v), powf(z, v)); }
+
+		constexpr void operator+=(const Vec3& other) { x += other.x; y += other.y; z += other.z; }
+		constexpr void operator+=(float v) { x += v; y += v; z += v; }
+		constexpr void operator-=(const Vec3& other) { x -= other.x; y -= other.y; z -= other.z; }
+		constexpr void operator-=(float v) { x -= v; y -= v; z -= v; }
+		constexpr void operator*=(const Vec3& other) { x *= other.x; y *= other.y; z *= other.z; }
+		constexpr void operator*=(float v) { x *= v; y *= v; z *= v; }
+		constexpr void operator/=(const Vec3& other) { x /= other.x; y /= other.y; z /= other.z; }
+		constexpr void operator/=(float v) { x /= v; y /= v; z /= v; }
+		void operator^=(const Vec3& other) { x = powf(x, other.x); y = powf(y, other.y); z = powf(z, other.z); }
+		void operator^=(float v) { x = powf(x, v); y = powf(y, v); z = powf(z, v); }
+
+		constexpr Vec3 operator-() const { return Vec3(-x, -y, -z); }
+
+		Vec3 Normalize() const
+		{
+			float len = sqrtf(x * x + y * y + z * z);
+			return Vec3(x / len, y / len, z / len);
+		}
+
+		constexpr Vec3 Cross(const Vec3& other) const
+		{
+			return Vec3(y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x);
+		}
+
+		float Distance(const Vec3& other) const
+		{
+			float dx = other.x - x;
+			float dy = other.y - y;
+			float dz = other.z - z;
+			return sqrtf(dx * dx + dy * dy + dz * dz);
+		}
 	};
 }
\ No newline at end of file
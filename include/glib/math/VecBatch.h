@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Vec2.h"
+
+#include <cstddef>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define GLIB_SIMD_SSE
+#include <xmmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define GLIB_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace glib
+{
+	/**
+	* A structure of arrays view on 2D vectors (e.g. all x positions next to each other, then all y positions).
+	*/
+	struct Vec2Span
+	{
+		float* x;
+		float* y;
+		size_t count;
+	};
+
+	/**
+	* dst[i] += src[i] * scale
+	*
+	* @param dst[in,out] - The values to add to
+	* @param src[in] - The values to scale and add
+	* @param scale[in] - The factor for every value of src
+	* @param count[in] - The amount of values
+	*/
+	inline void BatchMulAdd(float* dst, const float* src, float scale, size_t count)
+	{
+		size_t i = 0;
+#if defined(GLIB_SIMD_SSE)
+		__m128 s = _mm_set1_ps(scale);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 d = _mm_loadu_ps(dst + i);
+			_mm_storeu_ps(dst + i, _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(src + i), s)));
+		}
+#elif defined(GLIB_SIMD_NEON)
+		float32x4_t s = vdupq_n_f32(scale);
+		for (; i + 4 <= count; i += 4)
+		{
+			vst1q_f32(dst + i, vmlaq_f32(vld1q_f32(dst + i), vld1q_f32(src + i), s));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			dst[i] += src[i] * scale;
+		}
+	}
+
+	/**
+	* dst[i] = from[i] + (to[i] - from[i]) * t
+	*
+	* @param dst[out] - The interpolated values (may be the same as from or to)
+	* @param from[in] - The values at t = 0
+	* @param to[in] - The values at t = 1
+	* @param t[in] - The progress (usually the eased progress of a tween)
+	* @param count[in] - The amount of values
+	*/
+	inline void BatchLerp(float* dst, const float* from, const float* to, float t, size_t count)
+	{
+		size_t i = 0;
+#if defined(GLIB_SIMD_SSE)
+		__m128 s = _mm_set1_ps(t);
+		for (; i + 4 <= count; i += 4)
+		{
+			__m128 a = _mm_loadu_ps(from + i);
+			__m128 b = _mm_loadu_ps(to + i);
+			_mm_storeu_ps(dst + i, _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), s)));
+		}
+#elif defined(GLIB_SIMD_NEON)
+		float32x4_t s = vdupq_n_f32(t);
+		for (; i + 4 <= count; i += 4)
+		{
+			float32x4_t a = vld1q_f32(from + i);
+			vst1q_f32(dst + i, vmlaq_f32(a, vsubq_f32(vld1q_f32(to + i), a), s));
+		}
+#endif
+		for (; i < count; i++)
+		{
+			dst[i] = from[i] + (to[i] - from[i]) * t;
+		}
+	}
+
+	/**
+	* pos[i] += vel[i] * delta
+	*
+	* @param pos[in,out] - The positions
+	* @param vel[in] - The velocities (needs at least pos.count elements)
+	* @param delta[in] - The time step
+	*/
+	inline void BatchIntegrate(Vec2Span pos, const Vec2Span vel, float delta)
+	{
+		BatchMulAdd(pos.x, vel.x, delta, pos.count);
+		BatchMulAdd(pos.y, vel.y, delta, pos.count);
+	}
+
+	/**
+	* dst[i] += factors[i] * v (e.g. gravity that only applies to some objects, with factors of 0 or 1)
+	*
+	* @param dst[in,out] - The vectors to add to
+	* @param factors[in] - One factor per vector (needs at least dst.count elements)
+	* @param v[in] - The vector to add
+	*/
+	inline void BatchMulAdd(Vec2Span dst, const float* factors, const Vec2& v)
+	{
+		BatchMulAdd(dst.x, factors, v.x, dst.count);
+		BatchMulAdd(dst.y, factors, v.y, dst.count);
+	}
+
+	/**
+	* dst[i] = from[i] + (to[i] - from[i]) * t
+	*
+	* @param dst[out] - The interpolated vectors
+	* @param from[in] - The vectors at t = 0
+	* @param to[in] - The vectors at t = 1
+	* @param t[in] - The progress
+	*/
+	inline void BatchLerp(Vec2Span dst, const Vec2Span from, const Vec2Span to, float t)
+	{
+		BatchLerp(dst.x, from.x, to.x, t, dst.count);
+		BatchLerp(dst.y, from.y, to.y, t, dst.count);
+	}
+}
\ No newline at end of file
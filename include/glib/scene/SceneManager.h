@@ -20,6 +20,9 @@ namespace glib
 		Scene* m_CurrentScene;
 		double m_Last;
 		float m_MaxFPS;
+		bool m_RenderThread;
+
+		void RunThreaded();
 	public:
 		GLIB_API SceneManager(Instance* instance, Window* wnd);
 		GLIB_API ~SceneManager();
@@ -29,5 +32,18 @@ namespace glib
 
 		GLIB_API void Run(float maxFPS);
 		GLIB_API void SetMaxFPS(float maxFPS);
+
+		/**
+		* Draws on a dedicated render thread while the next frame is updated (one frame of pipelining). Off by default, takes effect on the next Run.
+		* 
+		* Every frame the visible sprites and texts are copied into a frame packet, which is all the render thread reads.
+		* Limitations:
+		* - Only the 2D CameraRenderer path reads packets. Video players, models and custom drawables are not drawn
+		* - Pipeline elements that draw drawables themselves aren't supported
+		* - OpenGL objects that are created or deleted by hand need Window::SetToCurrentContext / Window::SetNotToCurrentContext around them
+		* 
+		* @param toggle - Wether to use a render thread
+		*/
+		GLIB_API void SetRenderThread(bool toggle);
 	};
 }
\ No newline at end of file
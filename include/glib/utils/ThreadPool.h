@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../DLLDefs.h"
+
+#include <cstddef>
+#include <functional>
+
+namespace glib
+{
+	class ThreadPoolImpl;
+
+	/**
+	* A fixed set of worker threads that are started once and then reused.
+	*/
+	class ThreadPool
+	{
+	private:
+		ThreadPoolImpl* impl;
+	public:
+		/**
+		* @param threads[in] - The amount of worker threads (0 for one less than the hardware threads, but at least one)
+		*/
+		GLIB_API ThreadPool(unsigned int threads = 0);
+		GLIB_API ~ThreadPool();
+
+		/**
+		* Splits [0, count) into chunks and runs them on the workers and the calling thread. Returns once every chunk is done.
+		* The split only depends on count, minChunk and the thread count, so the same input always results in the same chunks.
+		*
+		* @param count[in] - The size of the range
+		* @param minChunk[in] - The smallest chunk worth sending to a worker. Chunk sizes are always a multiple of it (except for the last one)
+		* @param func[in] - Called with [begin, end) of a chunk, possibly on several threads at once
+		*/
+		GLIB_API void ParallelFor(size_t count, size_t minChunk, const std::function<void(size_t begin, size_t end)>& func);
+
+		/**
+		* Runs a job on one of the workers without waiting for it. Jobs that haven't started yet still run before the pool is destroyed.
+		*
+		* @param job[in] - The job
+		*/
+		GLIB_API void Enqueue(const std::function<void()>& job);
+
+		/**
+		* @returns The amount of worker threads
+		*/
+		GLIB_API unsigned int GetThreadCount() const;
+	};
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "../graphics/pipeline/RenderPipeline.h"
 #include "../graphics/Shader.h"
 #include "../graphics/Texture.h"
+#include "../graphics/TextureRequest.h"
 #include "../event/EventManager.h"
 #include "../sound/SoundManager.h"
 #include "../math/Vec2.h"
@@ -13,11 +14,13 @@
 #include "../graphics/3d/Model.h"
 
 #include <string>
+#include <memory>
 
 namespace glib
 {
 	class WindowImpl;
 	class Instance;
+	class RenderTargetPool;
 	struct WindowInitParams;
 
 	/**
@@ -63,6 +66,13 @@ namespace glib
 		*/
 		GLIB_API RenderPipeline* GetRenderPipeline();
 
+		/**
+		* Returns the pool the pipeline elements take their framebuffers from.
+		* 
+		* @returns The RenderTargetPool of this window
+		*/
+		GLIB_API RenderTargetPool* GetRenderTargetPool();
+
 		/**
 		* Draws everything to the screen by invoking RenderPipeline::Flush and doing some preperations.
 		*/
@@ -125,6 +135,9 @@ namespace glib
 		* 
 		* To load a shader from files use: Window::LoadShaderFromFiles.
 		* 
+		* NOTE: Every call returns a new program, so its uniforms are never shared.
+		* Set WindowInitParams::shaderCacheDirectory to keep the linked programs on disk, loading the same code again then skips compiling.
+		* 
 		* @param vertexCode - The code for the vertex shader
 		* @param fragmentCode - The code for the fragment shader
 		* 
@@ -143,6 +156,7 @@ namespace glib
 		* @returns A shader program compiled from the two provided shaders 
 		*/
 		GLIB_API Shader* LoadShaderFromFiles(const std::string& vertexPath, const std::string& fragmentPath);
+		Shader* LoadSharedShader(const std::string& vertexCode, const std::string& fragmentCode); // Internal (like LoadShader, but built-in elements with the same code get the same shader when the window manages its assets)
 
 		/**
 		* Loads a texture from an image file.
@@ -154,6 +168,26 @@ namespace glib
 		*/
 		GLIB_API Texture* LoadTexture(const std::string& path, bool pixelart = false);
 
+		/**
+		* Loads a texture from an image file without blocking the frame loop.
+		* The image is decoded on a worker thread and then uploaded over the next frames (see Window::SetTextureUploadBudget).
+		* The upload and the callback happen in Window::Update.
+		* 
+		* @param path - The path to the image file
+		* @param pixelart - Wether the image should be treated as pixel art (disables antialiasing)
+		* @param callback - Called with the texture once it can be used, or with nullptr if the image couldn't be loaded
+		* 
+		* @returns A handle to check the state of the load
+		*/
+		GLIB_API std::shared_ptr<TextureRequest> LoadTextureAsync(const std::string& path, bool pixelart = false, const TextureCallback& callback = nullptr);
+
+		/**
+		* Sets how many bytes of asynchronously loaded textures are uploaded per frame. Default is 4 MiB.
+		* 
+		* @param bytes - The upload budget per frame (at least one row of an image is always uploaded)
+		*/
+		GLIB_API void SetTextureUploadBudget(size_t bytes);
+
 		/**
 		* Loads a texture from a .apkg package file.
 		*
@@ -237,6 +271,8 @@ namespace glib
 
 		/**
 		* Enables the OpenGL and GLFW context of this window for this thread.
+		* With a render thread (see SceneManager::SetRenderThread) the context is locked until SetNotToCurrentContext is called,
+		* which is needed to create or delete OpenGL objects by hand (e.g. deleting a Text) on the update thread.
 		* @see glfwMakeContextCurrent
 		*/
 		GLIB_API void SetToCurrentContext();
@@ -311,5 +347,12 @@ namespace glib
 		GLIB_API void SetFullscreen(bool enabled);
 
 		void* GetHandle();
+
+		void LockContext(); // Internal (makes the context current on this thread, can be nested)
+		void UnlockContext(); // Internal
+		void SetThreaded(bool threaded); // Internal (the context is released after every UnlockContext, so another thread can use it)
+		bool HasExplicitContextLock() const; // Internal (whether SetToCurrentContext still holds the context on this thread)
+		void BuildFramePacket(FramePacket& packet); // Internal
+		void DrawFramePacket(const FramePacket& packet) const; // Internal (clears, flushes the pipeline with the packet and swaps)
 	};
 }
\ No newline at end of file
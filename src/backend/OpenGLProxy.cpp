@@ -1,43 +1,282 @@
 #include <glad/glad.h>
 #include "glib/backend/OpenGLProxy.h"
 
+#include <unordered_map>
+
+#define GLIB_PROXY_TEXTURE_UNITS 32
+#define GLIB_PROXY_UNKNOWN 0xFFFFFFFF
+
+namespace glib
+{
+	struct OpenGLState
+	{
+		void* context = nullptr;
+		std::unordered_map<int, bool> caps;
+		int blendSrc = -1;
+		int blendDst = -1;
+		bool viewportKnown = false;
+		int viewport[4] = { 0, 0, 0, 0 };
+		bool clearColorKnown = false;
+		float clearColor[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		int activeUnit = -1;
+		unsigned int textures[GLIB_PROXY_TEXTURE_UNITS];
+		unsigned int program = GLIB_PROXY_UNKNOWN;
+		unsigned int vao = GLIB_PROXY_UNKNOWN;
+		unsigned int drawFBO = GLIB_PROXY_UNKNOWN;
+		unsigned int readFBO = GLIB_PROXY_UNKNOWN;
+
+		OpenGLState()
+		{
+			Reset();
+		}
+
+		void Reset()
+		{
+			caps.clear();
+			blendSrc = -1;
+			blendDst = -1;
+			viewportKnown = false;
+			clearColorKnown = false;
+			activeUnit = -1;
+			for (int i = 0; i < GLIB_PROXY_TEXTURE_UNITS; i++)
+			{
+				textures[i] = GLIB_PROXY_UNKNOWN;
+			}
+			program = GLIB_PROXY_UNKNOWN;
+			vao = GLIB_PROXY_UNKNOWN;
+			drawFBO = GLIB_PROXY_UNKNOWN;
+			readFBO = GLIB_PROXY_UNKNOWN;
+		}
+	};
+
+	static OpenGLState s_State;
+	static OpenGLProxyStats s_FrameStats;
+	static OpenGLProxyStats s_Stats;
+
+	// Counts the call and returns true if it can be dropped
+	static bool Redundant(bool redundant)
+	{
+		if (redundant)
+		{
+			s_FrameStats.filtered++;
+			return true;
+		}
+		s_FrameStats.calls++;
+		return false;
+	}
+}
+
+using namespace glib;
 
 void glib::OpenGLProxy::Enable(int glenum)
 {
+	auto it = s_State.caps.find(glenum);
+	if (Redundant(it != s_State.caps.end() && it->second)) return;
+	s_State.caps[glenum] = true;
 	glEnable(glenum);
 }
 
+void glib::OpenGLProxy::Disable(int glenum)
+{
+	auto it = s_State.caps.find(glenum);
+	if (Redundant(it != s_State.caps.end() && !it->second)) return;
+	s_State.caps[glenum] = false;
+	glDisable(glenum);
+}
+
 void glib::OpenGLProxy::BlendFunc(int glenum1, int glenum2)
 {
+	if (Redundant(s_State.blendSrc == glenum1 && s_State.blendDst == glenum2)) return;
+	s_State.blendSrc = glenum1;
+	s_State.blendDst = glenum2;
 	glBlendFunc(glenum1, glenum2);
 }
 
 void glib::OpenGLProxy::Viewport(int x, int y, int w, int h)
 {
+	int* v = s_State.viewport;
+	if (Redundant(s_State.viewportKnown && v[0] == x && v[1] == y && v[2] == w && v[3] == h)) return;
+	s_State.viewportKnown = true;
+	v[0] = x;
+	v[1] = y;
+	v[2] = w;
+	v[3] = h;
 	glViewport(x, y, w, h);
 }
 
 void glib::OpenGLProxy::ClearColor(float r, float g, float b, float a)
 {
+	float* c = s_State.clearColor;
+	if (Redundant(s_State.clearColorKnown && c[0] == r && c[1] == g && c[2] == b && c[3] == a)) return;
+	s_State.clearColorKnown = true;
+	c[0] = r;
+	c[1] = g;
+	c[2] = b;
+	c[3] = a;
 	glClearColor(r, g, b, a);
 }
 
 void glib::OpenGLProxy::Clear(int bufferbits)
 {
+	s_FrameStats.calls++;
 	glClear(bufferbits);
 }
 
 void glib::OpenGLProxy::ActiveTexture(int glenum)
 {
+	int unit = glenum - GL_TEXTURE0;
+	if (Redundant(s_State.activeUnit == unit)) return;
+	s_State.activeUnit = unit;
 	glActiveTexture(glenum);
 }
 
-void glib::OpenGLProxy::DrawArrays(int glenum, int first, int count)
+void glib::OpenGLProxy::BindTexture(int target, unsigned int texture)
 {
-	glDrawArrays(glenum, first, count);
+	int unit = s_State.activeUnit;
+	if (target != GL_TEXTURE_2D || unit < 0 || unit >= GLIB_PROXY_TEXTURE_UNITS)
+	{
+		// Not tracked
+		s_FrameStats.calls++;
+		glBindTexture(target, texture);
+		return;
+	}
+
+	if (Redundant(s_State.textures[unit] == texture)) return;
+	s_State.textures[unit] = texture;
+	glBindTexture(target, texture);
+}
+
+void glib::OpenGLProxy::DeleteTextures(int n, const unsigned int* textures)
+{
+	// Deleted names are unbound by OpenGL and may be handed out again
+	for (int i = 0; i < n; i++)
+	{
+		for (int unit = 0; unit < GLIB_PROXY_TEXTURE_UNITS; unit++)
+		{
+			if (s_State.textures[unit] == textures[i])
+			{
+				s_State.textures[unit] = 0;
+			}
+		}
+	}
+	s_FrameStats.calls++;
+	glDeleteTextures(n, textures);
+}
+
+void glib::OpenGLProxy::UseProgram(unsigned int program)
+{
+	if (Redundant(s_State.program == program)) return;
+	s_State.program = program;
+	glUseProgram(program);
+}
+
+void glib::OpenGLProxy::DeleteProgram(unsigned int program)
+{
+	if (s_State.program == program)
+	{
+		s_State.program = GLIB_PROXY_UNKNOWN;
+	}
+	s_FrameStats.calls++;
+	glDeleteProgram(program);
 }
 
 void glib::OpenGLProxy::BindVertexArray(int vao)
 {
+	if (Redundant(s_State.vao == (unsigned int)vao)) return;
+	s_State.vao = (unsigned int)vao;
 	glBindVertexArray(vao);
 }
+
+void glib::OpenGLProxy::DeleteVertexArrays(int n, const unsigned int* vaos)
+{
+	for (int i = 0; i < n; i++)
+	{
+		if (s_State.vao == vaos[i])
+		{
+			s_State.vao = 0;
+		}
+	}
+	s_FrameStats.calls++;
+	glDeleteVertexArrays(n, vaos);
+}
+
+void glib::OpenGLProxy::BindFramebuffer(int target, unsigned int fbo)
+{
+	bool draw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+	bool read = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+	if (Redundant((!draw || s_State.drawFBO == fbo) && (!read || s_State.readFBO == fbo))) return;
+	if (draw) s_State.drawFBO = fbo;
+	if (read) s_State.readFBO = fbo;
+	glBindFramebuffer(target, fbo);
+}
+
+void glib::OpenGLProxy::DeleteFramebuffers(int n, const unsigned int* fbos)
+{
+	for (int i = 0; i < n; i++)
+	{
+		if (s_State.drawFBO == fbos[i]) s_State.drawFBO = 0;
+		if (s_State.readFBO == fbos[i]) s_State.readFBO = 0;
+	}
+	s_FrameStats.calls++;
+	glDeleteFramebuffers(n, fbos);
+}
+
+void glib::OpenGLProxy::DrawArrays(int glenum, int first, int count)
+{
+	s_FrameStats.calls++;
+	s_FrameStats.drawCalls++;
+	glDrawArrays(glenum, first, count);
+}
+
+void glib::OpenGLProxy::DrawArraysInstanced(int glenum, int first, int count, int instances)
+{
+	s_FrameStats.calls++;
+	s_FrameStats.drawCalls++;
+	glDrawArraysInstanced(glenum, first, count, instances);
+}
+
+void glib::OpenGLProxy::DrawElements(int glenum, int count, int type, const void* indices)
+{
+	s_FrameStats.calls++;
+	s_FrameStats.drawCalls++;
+	glDrawElements(glenum, count, type, indices);
+}
+
+void glib::OpenGLProxy::DrawElementsBaseVertex(int glenum, int count, int type, const void* indices, int baseVertex)
+{
+	s_FrameStats.calls++;
+	s_FrameStats.drawCalls++;
+	glDrawElementsBaseVertex(glenum, count, type, indices, baseVertex);
+}
+
+void glib::OpenGLProxy::DrawArraysInstancedBaseInstance(int glenum, int first, int count, int instances, unsigned int baseInstance)
+{
+	s_FrameStats.calls++;
+	s_FrameStats.drawCalls++;
+	glDrawArraysInstancedBaseInstance(glenum, first, count, instances, baseInstance);
+}
+
+void glib::OpenGLProxy::InvalidateState()
+{
+	void* context = s_State.context;
+	s_State.Reset();
+	s_State.context = context;
+}
+
+const OpenGLProxyStats& glib::OpenGLProxy::GetStats()
+{
+	return s_Stats;
+}
+
+void glib::OpenGLProxy::MakeCurrent(void* context)
+{
+	if (s_State.context == context) return;
+	s_State.Reset();
+	s_State.context = context;
+}
+
+void glib::OpenGLProxy::EndFrame()
+{
+	s_Stats = s_FrameStats;
+	s_FrameStats = OpenGLProxyStats();
+}
\ No newline at end of file
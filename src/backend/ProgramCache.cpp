@@ -0,0 +1,191 @@
+#include "glib/backend/ProgramCache.h"
+
+#include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+#define PROGRAM_CACHE_MAGIC 0x42505247 // "GRPB"
+#define PROGRAM_CACHE_VERSION 1
+
+namespace glib
+{
+	class ProgramCacheImpl
+	{
+	private:
+		std::string m_Directory;
+		std::string m_Driver;
+		bool m_Checked;
+		bool m_Supported;
+	public:
+		ProgramCacheImpl(const std::string& directory) : m_Directory(directory), m_Checked(false), m_Supported(false)
+		{
+		}
+
+		unsigned int Load(const std::string& vertexCode, const std::string& fragmentCode)
+		{
+			if (!CheckSupport()) return 0;
+
+			std::ifstream file(GetPath(vertexCode, fragmentCode), std::ios::binary);
+			if (!file) return 0;
+
+			// Both hashes are stored, so a collision of the file name alone can't load the wrong program
+			uint32_t magic = 0, version = 0, driverLength = 0, format = 0, length = 0;
+			uint64_t vertexHash = 0, fragmentHash = 0;
+			file.read((char*)&magic, sizeof(magic));
+			file.read((char*)&version, sizeof(version));
+			file.read((char*)&vertexHash, sizeof(vertexHash));
+			file.read((char*)&fragmentHash, sizeof(fragmentHash));
+			file.read((char*)&driverLength, sizeof(driverLength));
+			if (!file || magic != PROGRAM_CACHE_MAGIC || version != PROGRAM_CACHE_VERSION) return 0;
+			if (vertexHash != ProgramCache::Hash(vertexCode) || fragmentHash != ProgramCache::Hash(fragmentCode)) return 0;
+			if (driverLength != m_Driver.size()) return 0;
+
+			std::string driver(driverLength, '\0');
+			file.read(&driver[0], driverLength);
+			file.read((char*)&format, sizeof(format));
+			file.read((char*)&length, sizeof(length));
+			if (!file || driver != m_Driver) return 0;
+
+			// A truncated or corrupted file may claim more than it holds
+			std::streampos start = file.tellg();
+			file.seekg(0, std::ios::end);
+			std::streampos end = file.tellg();
+			if (start < 0 || end < start || (uint64_t)(end - start) < length) return 0;
+			file.seekg(start);
+
+			std::vector<char> binary(length);
+			file.read(binary.data(), length);
+			if (!file) return 0;
+
+			GLuint program = glCreateProgram();
+			glProgramBinary(program, format, binary.data(), (GLsizei)length);
+
+			// Drivers may still reject a binary after an update that kept the version string
+			GLint success = 0;
+			glGetProgramiv(program, GL_LINK_STATUS, &success);
+			if (!success)
+			{
+				OpenGLProxy::DeleteProgram(program);
+				return 0;
+			}
+
+			return program;
+		}
+
+		void Store(unsigned int program, const std::string& vertexCode, const std::string& fragmentCode)
+		{
+			if (!CheckSupport()) return;
+
+			GLint length = 0;
+			glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+			if (length <= 0) return;
+
+			std::vector<char> binary(length);
+			GLenum format = 0;
+			GLsizei written = 0;
+			glGetProgramBinary(program, length, &written, &format, binary.data());
+			if (written <= 0) return;
+
+			std::error_code error;
+			fs::create_directories(m_Directory, error);
+
+			// Written next to the final file and renamed, so another process never reads half a binary
+			std::string path = GetPath(vertexCode, fragmentCode);
+			std::string temp = path + ".tmp";
+			{
+				std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+				if (!file) return;
+
+				uint32_t magic = PROGRAM_CACHE_MAGIC, version = PROGRAM_CACHE_VERSION;
+				uint64_t vertexHash = ProgramCache::Hash(vertexCode), fragmentHash = ProgramCache::Hash(fragmentCode);
+				uint32_t driverLength = (uint32_t)m_Driver.size(), binaryFormat = format, binaryLength = (uint32_t)written;
+				file.write((const char*)&magic, sizeof(magic));
+				file.write((const char*)&version, sizeof(version));
+				file.write((const char*)&vertexHash, sizeof(vertexHash));
+				file.write((const char*)&fragmentHash, sizeof(fragmentHash));
+				file.write((const char*)&driverLength, sizeof(driverLength));
+				file.write(m_Driver.data(), driverLength);
+				file.write((const char*)&binaryFormat, sizeof(binaryFormat));
+				file.write((const char*)&binaryLength, sizeof(binaryLength));
+				file.write(binary.data(), written);
+				if (!file) return;
+			}
+			fs::rename(temp, path, error);
+		}
+
+		bool IsSupported() const
+		{
+			return m_Supported;
+		}
+	private:
+		bool CheckSupport()
+		{
+			if (m_Checked) return m_Supported;
+			m_Checked = true;
+
+			// Some drivers expose the functions without a single binary format
+			GLint formats = 0;
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+			m_Supported = formats > 0;
+
+			const char* vendor = (const char*)glGetString(GL_VENDOR);
+			const char* renderer = (const char*)glGetString(GL_RENDERER);
+			const char* version = (const char*)glGetString(GL_VERSION);
+			m_Driver = std::string(vendor ? vendor : "") + "\n" + (renderer ? renderer : "") + "\n" + (version ? version : "");
+			return m_Supported;
+		}
+
+		std::string GetPath(const std::string& vertexCode, const std::string& fragmentCode) const
+		{
+			uint64_t hash = ProgramCache::Hash(vertexCode) ^ (ProgramCache::Hash(fragmentCode) * 1099511628211ull);
+
+			std::stringstream ss;
+			ss << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+			return (fs::path(m_Directory) / ss.str()).string();
+		}
+	};
+}
+
+using namespace glib;
+
+glib::ProgramCache::ProgramCache(const std::string& directory)
+{
+	impl = new ProgramCacheImpl(directory);
+}
+
+glib::ProgramCache::~ProgramCache()
+{
+	delete impl;
+}
+
+unsigned int glib::ProgramCache::Load(const std::string& vertexCode, const std::string& fragmentCode)
+{
+	return impl->Load(vertexCode, fragmentCode);
+}
+
+void glib::ProgramCache::Store(unsigned int program, const std::string& vertexCode, const std::string& fragmentCode)
+{
+	impl->Store(program, vertexCode, fragmentCode);
+}
+
+bool glib::ProgramCache::IsSupported() const
+{
+	return impl->IsSupported();
+}
+
+uint64_t glib::ProgramCache::Hash(const std::string& source)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (char c : source)
+	{
+		hash ^= (unsigned char)c;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
\ No newline at end of file
@@ -0,0 +1,237 @@
+#include <glad/glad.h>
+#include "glib/backend/StreamBuffer.h"
+
+#include <cstring>
+
+namespace glib
+{
+	class StreamBufferImpl
+	{
+	private:
+		unsigned int m_Buffer;
+		int m_Target;
+		size_t m_Size;
+		size_t m_SegmentSize;
+		size_t m_Head;
+		size_t m_Segment;
+		unsigned int m_Written; // Bit mask of the segments written since they were last fenced
+		GLsync m_Fences[GLIB_STREAM_BUFFER_SEGMENTS];
+		char* m_Mapped;
+		bool m_RangeMapped; // Only used by the orphaning fallback
+		unsigned int m_Stalls;
+	public:
+		StreamBufferImpl(size_t size, int target) : m_Buffer(0), m_Target(target), m_Size(size), m_SegmentSize(0), m_Head(0), m_Segment(0), m_Written(0), m_Mapped(nullptr), m_RangeMapped(false), m_Stalls(0)
+		{
+			m_SegmentSize = (m_Size + GLIB_STREAM_BUFFER_SEGMENTS - 1) / GLIB_STREAM_BUFFER_SEGMENTS;
+			for (int i = 0; i < GLIB_STREAM_BUFFER_SEGMENTS; i++)
+			{
+				m_Fences[i] = nullptr;
+			}
+
+			glGenBuffers(1, &m_Buffer);
+			glBindBuffer(m_Target, m_Buffer);
+
+			if (GLAD_GL_VERSION_4_4 || GLAD_GL_ARB_buffer_storage)
+			{
+				GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+				glBufferStorage(m_Target, m_Size, nullptr, flags);
+				m_Mapped = (char*)glMapBufferRange(m_Target, 0, m_Size, flags);
+			}
+
+			if (m_Mapped == nullptr)
+			{
+				glBufferData(m_Target, m_Size, nullptr, GL_STREAM_DRAW);
+			}
+
+			glBindBuffer(m_Target, 0);
+		}
+
+		~StreamBufferImpl()
+		{
+			for (int i = 0; i < GLIB_STREAM_BUFFER_SEGMENTS; i++)
+			{
+				if (m_Fences[i] != nullptr) glDeleteSync(m_Fences[i]);
+			}
+
+			if (m_Mapped != nullptr)
+			{
+				glBindBuffer(m_Target, m_Buffer);
+				glUnmapBuffer(m_Target);
+				glBindBuffer(m_Target, 0);
+			}
+
+			glDeleteBuffers(1, &m_Buffer);
+		}
+
+		size_t Write(const void* data, size_t size, size_t alignment)
+		{
+			size_t offset = 0;
+			void* ptr = Map(size, alignment, offset);
+			if (ptr == nullptr) return 0;
+
+			memcpy(ptr, data, size);
+			Unmap();
+			return offset;
+		}
+
+		void* Map(size_t size, size_t alignment, size_t& offset)
+		{
+			offset = 0;
+			if (size == 0 || size > m_Size) return nullptr;
+
+			offset = (m_Head + alignment - 1) / alignment * alignment;
+			bool wrapped = offset + size > m_Size;
+			if (wrapped) offset = 0;
+
+			if (m_Mapped == nullptr)
+			{
+				return MapOrphaned(size, offset, wrapped);
+			}
+
+			size_t first = offset / m_SegmentSize;
+			size_t last = (offset + size - 1) / m_SegmentSize;
+
+			// Everything written so far is already drawn, so the segments we are leaving can be fenced now
+			if (first != m_Segment || wrapped)
+			{
+				for (size_t i = 0; i < GLIB_STREAM_BUFFER_SEGMENTS; i++)
+				{
+					if ((m_Written & (1u << i)) == 0) continue;
+					if (m_Fences[i] != nullptr) glDeleteSync(m_Fences[i]);
+					m_Fences[i] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+				}
+				m_Written = 0;
+			}
+
+			for (size_t i = first; i <= last; i++)
+			{
+				if ((m_Written & (1u << i)) == 0)
+				{
+					WaitForSegment(i);
+					m_Written |= 1u << i;
+				}
+			}
+
+			m_Segment = last;
+			m_Head = offset + size;
+			return m_Mapped + offset;
+		}
+
+		void* MapOrphaned(size_t size, size_t offset, bool wrapped)
+		{
+			glBindBuffer(m_Target, m_Buffer);
+
+			// A new storage for the next round, the driver keeps the old one alive until the GPU is done with it
+			if (wrapped)
+			{
+				glBufferData(m_Target, m_Size, nullptr, GL_STREAM_DRAW);
+			}
+
+			// This range hasn't been used since the last orphaning, so there's nothing to synchronize with
+			void* ptr = glMapBufferRange(m_Target, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+			m_RangeMapped = ptr != nullptr;
+
+			glBindBuffer(m_Target, 0);
+
+			m_Head = offset + size;
+			return ptr;
+		}
+
+		void Unmap()
+		{
+			// The persistent mapping stays, coherent writes are visible to the next draw call
+			if (!m_RangeMapped) return;
+			m_RangeMapped = false;
+
+			glBindBuffer(m_Target, m_Buffer);
+			glUnmapBuffer(m_Target);
+			glBindBuffer(m_Target, 0);
+		}
+
+		void WaitForSegment(size_t segment)
+		{
+			GLsync fence = m_Fences[segment];
+			if (fence == nullptr) return;
+
+			GLenum result = glClientWaitSync(fence, 0, 0);
+			if (result == GL_TIMEOUT_EXPIRED)
+			{
+				m_Stalls++;
+				do
+				{
+					result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+				} while (result == GL_TIMEOUT_EXPIRED);
+			}
+
+			glDeleteSync(fence);
+			m_Fences[segment] = nullptr;
+		}
+
+		unsigned int GetID() const
+		{
+			return m_Buffer;
+		}
+
+		size_t GetSize() const
+		{
+			return m_Size;
+		}
+
+		bool IsPersistent() const
+		{
+			return m_Mapped != nullptr;
+		}
+
+		unsigned int GetStallCount() const
+		{
+			return m_Stalls;
+		}
+	};
+}
+
+using namespace glib;
+
+glib::StreamBuffer::StreamBuffer(size_t size, int target)
+{
+	impl = new StreamBufferImpl(size, target);
+}
+
+glib::StreamBuffer::~StreamBuffer()
+{
+	delete impl;
+}
+
+size_t glib::StreamBuffer::Write(const void* data, size_t size, size_t alignment)
+{
+	return impl->Write(data, size, alignment);
+}
+
+void* glib::StreamBuffer::Map(size_t size, size_t alignment, size_t& offset)
+{
+	return impl->Map(size, alignment, offset);
+}
+
+void glib::StreamBuffer::Unmap()
+{
+	impl->Unmap();
+}
+
+unsigned int glib::StreamBuffer::GetID() const
+{
+	return impl->GetID();
+}
+
+size_t glib::StreamBuffer::GetSize() const
+{
+	return impl->GetSize();
+}
+
+bool glib::StreamBuffer::IsPersistent() const
+{
+	return impl->IsPersistent();
+}
+
+unsigned int glib::StreamBuffer::GetStallCount() const
+{
+	return impl->GetStallCount();
+}
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "glib/glibError.h"
 
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 
 extern int __GLIB_ERROR_CODE;
 extern void glib_print_error();
@@ -18,12 +19,12 @@ namespace glib
 		FramebufferImpl(FramebufferType type, const Vec2& dimensions) : m_FBO(0), m_TexID(0), m_RBO(0)
 		{
 			glGenFramebuffers(1, &m_FBO);
-			glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+			OpenGLProxy::BindFramebuffer(GL_FRAMEBUFFER, m_FBO);
 
 			if (type == FramebufferType::TEXTURE)
 			{
 				glGenTextures(1, &m_TexID);
-				glBindTexture(GL_TEXTURE_2D, m_TexID);
+				OpenGLProxy::BindTexture(GL_TEXTURE_2D, m_TexID);
 				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, dimensions.x, dimensions.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
 
 				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -37,7 +38,7 @@ namespace glib
 					glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, largest);
 				}
 
-				glBindTexture(GL_TEXTURE_2D, 0);
+				OpenGLProxy::BindTexture(GL_TEXTURE_2D, 0);
 
 				glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_TexID, 0);
 			}
@@ -45,8 +46,8 @@ namespace glib
 			{
 				__GLIB_ERROR_CODE = GLIB_FRAMEBUFFER_UNKNOWN_TYPE;
 				glib_print_error();
-				glBindFramebuffer(GL_FRAMEBUFFER, 0);
-				glDeleteFramebuffers(1, &m_FBO);
+				OpenGLProxy::BindFramebuffer(GL_FRAMEBUFFER, 0);
+				OpenGLProxy::DeleteFramebuffers(1, &m_FBO);
 				return;
 			}
 
@@ -57,31 +58,31 @@ namespace glib
 				return;
 			}
 			
-			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			OpenGLProxy::BindFramebuffer(GL_FRAMEBUFFER, 0);
 		}
 
 		~FramebufferImpl()
 		{
-			glDeleteFramebuffers(1, &m_FBO);
+			OpenGLProxy::DeleteFramebuffers(1, &m_FBO);
 			if (m_TexID != 0)
 			{
-				glDeleteTextures(1, &m_TexID);
+				OpenGLProxy::DeleteTextures(1, &m_TexID);
 			}
 		}
 
 		void Bind()
 		{
-			glBindFramebuffer(GL_FRAMEBUFFER, m_FBO);
+			OpenGLProxy::BindFramebuffer(GL_FRAMEBUFFER, m_FBO);
 		}
 
 		void Unbind()
 		{
-			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			OpenGLProxy::BindFramebuffer(GL_FRAMEBUFFER, 0);
 		}
 
 		FBInternals GetInternals()
 		{
-			return { m_TexID };
+			return { m_TexID, m_FBO };
 		}
 	};
 }
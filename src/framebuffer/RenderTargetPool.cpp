@@ -0,0 +1,189 @@
+#include "glib/framebuffer/RenderTargetPool.h"
+
+#include <vector>
+
+namespace glib
+{
+	struct RenderTarget
+	{
+		Framebuffer* framebuffer;
+		unsigned int texture;
+		int width;
+		int height;
+		FramebufferType type;
+		bool inUse;
+		bool used; // Acquired since the last EndFrame
+		bool retained; // Kept across frames until UnretainTexture
+	};
+
+	class RenderTargetPoolImpl
+	{
+	private:
+		std::vector<RenderTarget> m_Targets;
+	public:
+		~RenderTargetPoolImpl()
+		{
+			for (RenderTarget& target : m_Targets)
+			{
+				delete target.framebuffer;
+			}
+		}
+
+		Framebuffer* Acquire(const Vec2& size, FramebufferType type)
+		{
+			int width = (int)size.x;
+			int height = (int)size.y;
+
+			for (RenderTarget& target : m_Targets)
+			{
+				if (target.inUse || target.width != width || target.height != height || target.type != type) continue;
+
+				target.inUse = true;
+				target.used = true;
+				return target.framebuffer;
+			}
+
+			RenderTarget target{};
+			target.framebuffer = new Framebuffer(type, Vec2((float)width, (float)height));
+			target.texture = target.framebuffer->GetInternals().tex;
+			target.width = width;
+			target.height = height;
+			target.type = type;
+			target.inUse = true;
+			target.used = true;
+			m_Targets.push_back(target);
+			return target.framebuffer;
+		}
+
+		void Release(Framebuffer* framebuffer)
+		{
+			for (RenderTarget& target : m_Targets)
+			{
+				if (target.framebuffer != framebuffer) continue;
+				if (!target.retained) target.inUse = false;
+				return;
+			}
+		}
+
+		void ReleaseTexture(unsigned int texture)
+		{
+			if (texture == 0) return;
+
+			for (RenderTarget& target : m_Targets)
+			{
+				if (target.texture != texture) continue;
+				if (!target.retained) target.inUse = false;
+				return;
+			}
+		}
+
+		void SetRetained(unsigned int texture, bool retained)
+		{
+			if (texture == 0) return;
+
+			for (RenderTarget& target : m_Targets)
+			{
+				if (target.texture != texture) continue;
+				target.retained = retained;
+				target.inUse = retained;
+				target.used = true;
+				return;
+			}
+		}
+
+		Framebuffer* FindTarget(unsigned int texture, Vec2& size) const
+		{
+			if (texture == 0) return nullptr;
+
+			for (const RenderTarget& target : m_Targets)
+			{
+				if (target.texture != texture) continue;
+				size = Vec2((float)target.width, (float)target.height);
+				return target.framebuffer;
+			}
+			return nullptr;
+		}
+
+		void EndFrame()
+		{
+			size_t kept = 0;
+			for (size_t i = 0; i < m_Targets.size(); i++)
+			{
+				RenderTarget& target = m_Targets[i];
+				if (target.retained)
+				{
+					m_Targets[kept++] = target;
+					continue;
+				}
+
+				if (!target.used)
+				{
+					delete target.framebuffer;
+					continue;
+				}
+
+				target.inUse = false;
+				target.used = false;
+				m_Targets[kept++] = target;
+			}
+			m_Targets.resize(kept);
+		}
+
+		size_t GetTargetCount() const
+		{
+			return m_Targets.size();
+		}
+	};
+}
+
+using namespace glib;
+
+glib::RenderTargetPool::RenderTargetPool()
+{
+	impl = new RenderTargetPoolImpl();
+}
+
+glib::RenderTargetPool::~RenderTargetPool()
+{
+	delete impl;
+}
+
+Framebuffer* glib::RenderTargetPool::Acquire(const Vec2& size, FramebufferType type)
+{
+	return impl->Acquire(size, type);
+}
+
+void glib::RenderTargetPool::Release(Framebuffer* target)
+{
+	impl->Release(target);
+}
+
+void glib::RenderTargetPool::ReleaseTexture(unsigned int texture)
+{
+	impl->ReleaseTexture(texture);
+}
+
+void glib::RenderTargetPool::RetainTexture(unsigned int texture)
+{
+	impl->SetRetained(texture, true);
+}
+
+void glib::RenderTargetPool::UnretainTexture(unsigned int texture)
+{
+	impl->SetRetained(texture, false);
+}
+
+Framebuffer* glib::RenderTargetPool::FindTarget(unsigned int texture, Vec2& size) const
+{
+	return impl->FindTarget(texture, size);
+}
+
+void glib::RenderTargetPool::EndFrame()
+{
+	impl->EndFrame();
+}
+
+size_t glib::RenderTargetPool::GetTargetCount() const
+{
+	return impl->GetTargetCount();
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "glib/graphics/3d/Mesh.h"
 
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 
 using namespace glib;
 
@@ -10,7 +11,7 @@ glib::Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned
     glGenBuffers(1, &m_VBO);
     glGenBuffers(1, &m_EBO);
 
-    glBindVertexArray(m_VAO);
+    OpenGLProxy::BindVertexArray(m_VAO);
 
     glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
 
@@ -41,14 +42,14 @@ glib::Mesh::Mesh(const std::vector<Vertex>& vertices, const std::vector<unsigned
     // weights
     glEnableVertexAttribArray(6);
     glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, weights));
-    glBindVertexArray(0);
+    OpenGLProxy::BindVertexArray(0);
 
-    glBindVertexArray(0);
+    OpenGLProxy::BindVertexArray(0);
 }
 
 glib::Mesh::~Mesh()
 {
-    glDeleteVertexArrays(1, &m_VAO);
+    OpenGLProxy::DeleteVertexArrays(1, &m_VAO);
     glDeleteBuffers(1, &m_VBO);
     glDeleteBuffers(1, &m_EBO);
 }
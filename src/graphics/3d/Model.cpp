@@ -5,6 +5,7 @@
 #include <assimp/postprocess.h>
 #include <iostream>
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 #include <stb_image.h>
 #include <filesystem>
 
@@ -51,7 +52,7 @@ static unsigned int TextureFromFile(const char* path, const std::string& directo
         else if (nrComponents == 4)
             format = GL_RGBA;
 
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        OpenGLProxy::BindTexture(GL_TEXTURE_2D, textureID);
         glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
         glGenerateMipmap(GL_TEXTURE_2D);
 
@@ -122,7 +123,7 @@ static unsigned int TextureFromMemory(const aiTexture* tex, LoadState& state)
         ConvertBetweenBGRAandRGBA((unsigned char*)tex->pcData, tex->mWidth, tex->mHeight, data);
     }
 
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    OpenGLProxy::BindTexture(GL_TEXTURE_2D, textureID);
     glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
     glGenerateMipmap(GL_TEXTURE_2D);
 
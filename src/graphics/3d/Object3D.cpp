@@ -4,6 +4,7 @@
 glib::Object3D::Object3D() : pos(Vec3(0.0f, 0.0f, 0.0f)), scale(Vec3(1.0f, 1.0f, 1.0f)), color({ 1.0f, 1.0f, 1.0f, 1.0f }), model(nullptr), uvSize(glib::Vec2(1.0f, 1.0f))
 {
     visible = true;
+    kind = GLIB_DRAWABLE_OBJECT_3D;
 }
 
 glib::Object3D::~Object3D()
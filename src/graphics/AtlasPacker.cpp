@@ -0,0 +1,173 @@
+#include "glib/graphics/AtlasPacker.h"
+
+#include <vector>
+#include <cstddef>
+
+namespace glib
+{
+	class AtlasPackerImpl
+	{
+	private:
+		struct SkylineNode
+		{
+			int x;
+			int y;
+			int width;
+		};
+	private:
+		int m_Width;
+		int m_Height;
+		long long m_UsedArea;
+		std::vector<SkylineNode> m_Skyline;
+	public:
+		AtlasPackerImpl(int width, int height) : m_Width(width), m_Height(height), m_UsedArea(0)
+		{
+			Reset();
+		}
+
+		void Reset()
+		{
+			m_UsedArea = 0;
+			m_Skyline.clear();
+			m_Skyline.push_back({ 0, 0, m_Width });
+		}
+
+		bool Pack(int width, int height, Vec2i& outPos)
+		{
+			if (width <= 0 || height <= 0) return false;
+
+			int bestY = m_Height;
+			int bestWidth = m_Width + 1;
+			int bestIndex = -1;
+
+			for (size_t i = 0; i < m_Skyline.size(); i++)
+			{
+				int y;
+				if (!Fits(i, width, height, y)) continue;
+
+				// Bottom-left rule, ties are broken by the narrower segment to waste less space
+				if (y < bestY || (y == bestY && m_Skyline[i].width < bestWidth))
+				{
+					bestY = y;
+					bestWidth = m_Skyline[i].width;
+					bestIndex = (int)i;
+				}
+			}
+
+			if (bestIndex == -1) return false;
+
+			outPos = Vec2i(m_Skyline[bestIndex].x, bestY);
+			AddLevel(bestIndex, outPos.x, outPos.y, width, height);
+			m_UsedArea += (long long)width * height;
+			return true;
+		}
+
+		float GetOccupancy() const
+		{
+			return (float)((double)m_UsedArea / ((double)m_Width * m_Height));
+		}
+
+		int GetWidth() const
+		{
+			return m_Width;
+		}
+
+		int GetHeight() const
+		{
+			return m_Height;
+		}
+	private:
+		bool Fits(size_t index, int width, int height, int& outY) const
+		{
+			int x = m_Skyline[index].x;
+			if (x + width > m_Width) return false;
+
+			int widthLeft = width;
+			int y = m_Skyline[index].y;
+
+			while (widthLeft > 0)
+			{
+				if (index >= m_Skyline.size()) return false;
+
+				if (m_Skyline[index].y > y) y = m_Skyline[index].y;
+				if (y + height > m_Height) return false;
+
+				widthLeft -= m_Skyline[index].width;
+				index++;
+			}
+
+			outY = y;
+			return true;
+		}
+
+		void AddLevel(int index, int x, int y, int width, int height)
+		{
+			m_Skyline.insert(m_Skyline.begin() + index, { x, y + height, width });
+
+			for (size_t i = index + 1; i < m_Skyline.size(); i++)
+			{
+				SkylineNode& prev = m_Skyline[i - 1];
+				SkylineNode& node = m_Skyline[i];
+
+				if (node.x >= prev.x + prev.width) break;
+
+				int shrink = prev.x + prev.width - node.x;
+				node.x += shrink;
+				node.width -= shrink;
+
+				if (node.width > 0) break;
+
+				m_Skyline.erase(m_Skyline.begin() + i);
+				i--;
+			}
+
+			// Merge neighbours on the same level
+			for (size_t i = 0; i + 1 < m_Skyline.size(); i++)
+			{
+				if (m_Skyline[i].y == m_Skyline[i + 1].y)
+				{
+					m_Skyline[i].width += m_Skyline[i + 1].width;
+					m_Skyline.erase(m_Skyline.begin() + i + 1);
+					i--;
+				}
+			}
+		}
+	};
+}
+
+using namespace glib;
+
+glib::AtlasPacker::AtlasPacker(int width, int height)
+{
+	impl = new AtlasPackerImpl(width, height);
+}
+
+glib::AtlasPacker::~AtlasPacker()
+{
+	delete impl;
+}
+
+bool glib::AtlasPacker::Pack(int width, int height, Vec2i& outPos)
+{
+	return impl->Pack(width, height, outPos);
+}
+
+void glib::AtlasPacker::Reset()
+{
+	impl->Reset();
+}
+
+float glib::AtlasPacker::GetOccupancy() const
+{
+	return impl->GetOccupancy();
+}
+
+int glib::AtlasPacker::GetWidth() const
+{
+	return impl->GetWidth();
+}
+
+int glib::AtlasPacker::GetHeight() const
+{
+	return impl->GetHeight();
+}
\ No newline at end of file
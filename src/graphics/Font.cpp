@@ -1,17 +1,25 @@
 #include "glib/graphics/Font.h"
 #include "glib/apkg/apkg.h"
+#include "glib/graphics/AtlasPacker.h"
 
 #include <freetype/freetype.h>
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 #include <unordered_map>
+#include <vector>
 #include <iostream>
 
+#define GLYPH_PADDING 1
+
 namespace glib
 {
 	class FontImpl
 	{
 	private:
 		std::unordered_map<wchar_t, Glyph> m_Glyphs;
+        std::vector<unsigned int> m_Pages;
+        AtlasPacker* m_Packer = nullptr;
+        bool m_Pixelart = false;
 	public:
 		FontImpl(const std::string& path, wchar_t* alphabet, size_t alphabetLen, int size, bool pixelart)
 		{
@@ -29,61 +37,7 @@ namespace glib
                 return;
             }
 
-            FT_Select_Charmap(face, FT_ENCODING_UNICODE);
-            FT_Set_Pixel_Sizes(face, 0, size);
-
-            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-            for (int i = 0; i < alphabetLen; i++)
-            {
-                FT_UInt glyph_index = FT_Get_Char_Index(face, alphabet[i]);
-
-                FT_Load_Glyph(face, glyph_index, FT_LOAD_RENDER);
-
-                unsigned int texture = 0;
-                glGenTextures(1, &texture);
-                glBindTexture(GL_TEXTURE_2D, texture);
-                glTexImage2D(
-                    GL_TEXTURE_2D,
-                    0,
-                    GL_RED,
-                    face->glyph->bitmap.width,
-                    face->glyph->bitmap.rows,
-                    0,
-                    GL_RED,
-                    GL_UNSIGNED_BYTE,
-                    face->glyph->bitmap.buffer
-                );
-
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-                
-                if (pixelart)
-                {
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-                }
-                else
-                {
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                }
-
-                if (GL_EXT_texture_filter_anisotropic) {
-                    GLfloat largest = 0;
-                    glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &largest);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, largest);
-                }
-
-                Glyph glyph = {
-                    texture,
-                    Vec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
-                    Vec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-                    face->glyph->advance.x
-                };
-
-                m_Glyphs.insert({ alphabet[i], glyph });
-            }
+            LoadGlyphs(face, alphabet, alphabetLen, size, pixelart);
 
             FT_Done_Face(face);
             FT_Done_FreeType(ft);
@@ -107,85 +61,133 @@ namespace glib
                 return;
             }
 
+            LoadGlyphs(face, alphabet, alphabetLen, size, pixelart);
+
+            FT_Done_Face(face);
+            FT_Done_FreeType(ft);
+            delete[] fd.buf;
+        }
+
+		~FontImpl()
+		{
+            for (unsigned int page : m_Pages)
+            {
+                OpenGLProxy::DeleteTextures(1, &page);
+            }
+            delete m_Packer;
+		}
+
+        const Glyph& GetGlyph(wchar_t c)
+        {
+            try
+            {
+                return m_Glyphs.at(c);
+            }
+            catch (std::exception e)
+            {
+                return m_Glyphs.at(0);
+            }
+        }
+    private:
+        void LoadGlyphs(FT_Face face, wchar_t* alphabet, size_t alphabetLen, int size, bool pixelart)
+        {
+            m_Pixelart = pixelart;
+
             FT_Select_Charmap(face, FT_ENCODING_UNICODE);
             FT_Set_Pixel_Sizes(face, 0, size);
 
             glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
+            // All glyphs of a font usually fit into one page, so a whole text can be drawn with one texture
+            int pageSize = 256;
+            while (pageSize < 8192 && (pageSize < (size + GLYPH_PADDING * 2) * 2 || (pageSize / (size + GLYPH_PADDING * 2)) * (pageSize / (size + GLYPH_PADDING * 2)) < (int)alphabetLen))
+            {
+                pageSize *= 2;
+            }
+
+            m_Packer = new AtlasPacker(pageSize, pageSize);
+            NewPage(pageSize);
+
             for (int i = 0; i < alphabetLen; i++)
             {
                 FT_UInt glyph_index = FT_Get_Char_Index(face, alphabet[i]);
 
                 FT_Load_Glyph(face, glyph_index, FT_LOAD_RENDER);
 
-                unsigned int texture = 0;
-                glGenTextures(1, &texture);
-                glBindTexture(GL_TEXTURE_2D, texture);
-                glTexImage2D(
-                    GL_TEXTURE_2D,
-                    0,
-                    GL_RED,
-                    face->glyph->bitmap.width,
-                    face->glyph->bitmap.rows,
-                    0,
-                    GL_RED,
-                    GL_UNSIGNED_BYTE,
-                    face->glyph->bitmap.buffer
-                );
-
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-                if (pixelart)
-                {
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-                }
-                else
-                {
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-                }
-
-                if (GL_EXT_texture_filter_anisotropic) {
-                    GLfloat largest = 0;
-                    glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &largest);
-                    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, largest);
-                }
+                int width = face->glyph->bitmap.width;
+                int height = face->glyph->bitmap.rows;
 
                 Glyph glyph = {
-                    texture,
-                    Vec2(face->glyph->bitmap.width, face->glyph->bitmap.rows),
+                    m_Pages.back(),
+                    Vec2(width, height),
                     Vec2(face->glyph->bitmap_left, face->glyph->bitmap_top),
-                    face->glyph->advance.x
+                    face->glyph->advance.x,
+                    Vec2(0.0f, 0.0f),
+                    Vec2(0.0f, 0.0f)
                 };
 
+                if (width > 0 && height > 0)
+                {
+                    Vec2i pos;
+                    if (!m_Packer->Pack(width + GLYPH_PADDING * 2, height + GLYPH_PADDING * 2, pos))
+                    {
+                        m_Packer->Reset();
+                        NewPage(pageSize);
+                        if (!m_Packer->Pack(width + GLYPH_PADDING * 2, height + GLYPH_PADDING * 2, pos))
+                        {
+                            std::cout << "Glyph is too big for the atlas page!" << std::endl;
+                            m_Glyphs.insert({ alphabet[i], glyph });
+                            continue;
+                        }
+                    }
+
+                    int x = pos.x + GLYPH_PADDING;
+                    int y = pos.y + GLYPH_PADDING;
+
+                    OpenGLProxy::BindTexture(GL_TEXTURE_2D, m_Pages.back());
+                    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RED, GL_UNSIGNED_BYTE, face->glyph->bitmap.buffer);
+
+                    glyph.tex = m_Pages.back();
+                    glyph.uvPos = Vec2(x / (float)pageSize, y / (float)pageSize);
+                    glyph.uvSize = Vec2(width / (float)pageSize, height / (float)pageSize);
+                }
+
                 m_Glyphs.insert({ alphabet[i], glyph });
             }
 
-            FT_Done_Face(face);
-            FT_Done_FreeType(ft);
-            delete[] fd.buf;
+            OpenGLProxy::BindTexture(GL_TEXTURE_2D, 0);
         }
 
-		~FontImpl()
-		{
-            for (const auto& v : m_Glyphs)
-            {
-                glDeleteTextures(1, &v.second.tex);
-            }
-		}
-
-        const Glyph& GetGlyph(wchar_t c)
+        void NewPage(int pageSize)
         {
-            try
+            unsigned int texture = 0;
+            glGenTextures(1, &texture);
+            OpenGLProxy::BindTexture(GL_TEXTURE_2D, texture);
+
+            std::vector<unsigned char> empty((size_t)pageSize * pageSize, 0);
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, pageSize, pageSize, 0, GL_RED, GL_UNSIGNED_BYTE, empty.data());
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+            if (m_Pixelart)
             {
-                return m_Glyphs.at(c);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
             }
-            catch (std::exception e)
+            else
             {
-                return m_Glyphs.at(0);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
             }
+
+            if (GL_EXT_texture_filter_anisotropic) {
+                GLfloat largest = 0;
+                glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &largest);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, largest);
+            }
+
+            m_Pages.push_back(texture);
         }
 	};
 }
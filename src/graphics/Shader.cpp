@@ -1,60 +1,132 @@
 #include "glib/graphics/Shader.h"
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 #include <glm.hpp>
 #include <gtc/matrix_transform.hpp>
 #include <gtc/type_ptr.hpp>
 #include <iostream>
+#include <unordered_map>
+#include <vector>
 
 namespace glib
 {
+	struct ShaderUniform
+	{
+		std::string name;
+		GLenum type;
+		int location;
+	};
+
 	class ShaderImpl
 	{
 	private:
 		GLuint m_ID;
+		std::unordered_map<std::string, int> m_Locations;
+		std::vector<ShaderUniform> m_Uniforms; // Active uniforms that aren't arrays, for CopyUniforms
 	public:
 		ShaderImpl(GLuint id) : m_ID(id)
 		{
+			// Fill the location cache with every active uniform of the linked program
+			GLint count = 0;
+			GLint maxLength = 0;
+			glGetProgramiv(m_ID, GL_ACTIVE_UNIFORMS, &count);
+			glGetProgramiv(m_ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+			std::vector<char> name(maxLength > 0 ? maxLength : 1);
+			for (GLint i = 0; i < count; i++)
+			{
+				GLsizei length = 0;
+				GLint size = 0;
+				GLenum type = 0;
+				glGetActiveUniform(m_ID, (GLuint)i, (GLsizei)name.size(), &length, &size, &type, name.data());
+
+				std::string uniform(name.data(), length);
+				m_Locations[uniform] = glGetUniformLocation(m_ID, uniform.c_str());
+				if (size == 1) m_Uniforms.push_back({ uniform, type, m_Locations[uniform] });
+
+				// Arrays are reported as "name[0]" but are usually set as "name"
+				if (uniform.size() > 3 && uniform.compare(uniform.size() - 3, 3, "[0]") == 0)
+				{
+					m_Locations[uniform.substr(0, uniform.size() - 3)] = m_Locations[uniform];
+				}
+			}
 		}
 
 		~ShaderImpl()
 		{
-			glDeleteProgram(m_ID);
+			OpenGLProxy::DeleteProgram(m_ID);
 		}
 		
 		void Use() const
 		{
-			glUseProgram(m_ID);
+			OpenGLProxy::UseProgram(m_ID);
 		}
 
 		int GetUniformLocation(const std::string& name)
 		{
-			return glGetUniformLocation(m_ID, name.c_str());
+			auto it = m_Locations.find(name);
+			if (it != m_Locations.end())
+			{
+				return it->second;
+			}
+
+			// Not an active uniform (e.g. an array element), remember the result anyway
+			int location = glGetUniformLocation(m_ID, name.c_str());
+			m_Locations.insert({ name, location });
+			return location;
 		}
 
-		void SetMat4(const std::string& name, Mat4& mat)
+		void SetMat4(int location, Mat4& mat)
 		{
 			glm::mat4 m = *((glm::mat4*)mat.GetPtr());
-			glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, glm::value_ptr(m));
+			glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(m));
 		}
 
-		void SetInt(const std::string& name, int i)
+		void SetInt(int location, int i)
 		{
-			glUniform1i(GetUniformLocation(name), i);
+			glUniform1i(location, i);
 		}
 
-		void SetColor(const std::string& name, const Color& color)
+		void SetColor(int location, const Color& color)
 		{
-			glUniform4f(GetUniformLocation(name), color.r, color.g, color.b, color.a);
+			glUniform4f(location, color.r, color.g, color.b, color.a);
 		}
 
-		void SetFloat(const std::string& name, float f)
+		void SetFloat(int location, float f)
 		{
-			glUniform1f(GetUniformLocation(name), f);
+			glUniform1f(location, f);
 		}
 
-		void SetVec2(const std::string& name, const Vec2& vec)
+		void SetVec2(int location, const Vec2& vec)
 		{
-			glUniform2f(GetUniformLocation(name), vec.x, vec.y);
+			glUniform2f(location, vec.x, vec.y);
+		}
+
+		void CopyUniforms(ShaderImpl* target)
+		{
+			GLfloat f[16];
+			GLint i[4];
+			for (const ShaderUniform& uniform : m_Uniforms)
+			{
+				// The glib_ uniforms are set by whoever draws with the target
+				if (uniform.name.compare(0, 5, "glib_") == 0) continue;
+
+				int location = target->GetUniformLocation(uniform.name);
+				if (location == -1) continue;
+
+				switch (uniform.type)
+				{
+				case GL_FLOAT: glGetUniformfv(m_ID, uniform.location, f); glUniform1fv(location, 1, f); break;
+				case GL_FLOAT_VEC2: glGetUniformfv(m_ID, uniform.location, f); glUniform2fv(location, 1, f); break;
+				case GL_FLOAT_VEC3: glGetUniformfv(m_ID, uniform.location, f); glUniform3fv(location, 1, f); break;
+				case GL_FLOAT_VEC4: glGetUniformfv(m_ID, uniform.location, f); glUniform4fv(location, 1, f); break;
+				case GL_FLOAT_MAT4: glGetUniformfv(m_ID, uniform.location, f); glUniformMatrix4fv(location, 1, GL_FALSE, f); break;
+				case GL_INT:
+				case GL_BOOL:
+				case GL_SAMPLER_2D: glGetUniformiv(m_ID, uniform.location, i); glUniform1iv(location, 1, i); break;
+				default: break;
+				}
+			}
 		}
 	};
 }
@@ -83,25 +155,63 @@ int glib::Shader::GetUniformLocation(const std::string& name)
 
 void glib::Shader::SetMat4(const std::string& name, Mat4& mat)
 {
-	impl->SetMat4(name, mat);
+	impl->SetMat4(impl->GetUniformLocation(name), mat);
 }
 
 void glib::Shader::SetInt(const std::string& name, int i)
 {
-	impl->SetInt(name, i);
+	impl->SetInt(impl->GetUniformLocation(name), i);
 }
 
 void glib::Shader::SetColor(const std::string& name, const Color& color)
 {
-	impl->SetColor(name, color);
+	impl->SetColor(impl->GetUniformLocation(name), color);
 }
 
 void glib::Shader::SetFloat(const std::string& name, float f)
 {
-	impl->SetFloat(name, f);
+	impl->SetFloat(impl->GetUniformLocation(name), f);
 }
 
 void glib::Shader::SetVec2(const std::string& name, const Vec2& vec)
 {
-	impl->SetVec2(name, vec);
+	impl->SetVec2(impl->GetUniformLocation(name), vec);
+}
+
+UniformHandle glib::Shader::GetUniform(const std::string& name)
+{
+	UniformHandle uniform;
+	uniform.location = impl->GetUniformLocation(name);
+	return uniform;
 }
+
+void glib::Shader::SetMat4(UniformHandle uniform, Mat4& mat)
+{
+	impl->SetMat4(uniform.location, mat);
+}
+
+void glib::Shader::SetInt(UniformHandle uniform, int i)
+{
+	impl->SetInt(uniform.location, i);
+}
+
+void glib::Shader::SetColor(UniformHandle uniform, const Color& color)
+{
+	impl->SetColor(uniform.location, color);
+}
+
+void glib::Shader::SetFloat(UniformHandle uniform, float f)
+{
+	impl->SetFloat(uniform.location, f);
+}
+
+void glib::Shader::SetVec2(UniformHandle uniform, const Vec2& vec)
+{
+	impl->SetVec2(uniform.location, vec);
+}
+
+
+void glib::Shader::CopyUniforms(Shader* target)
+{
+	impl->CopyUniforms(target->impl);
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "glib/graphics/Sprite.h"
 #include "glib/utils/Easing.h"
 #include "glib/animation/AnimationManager.h"
+#include "glib/math/Affine2D.h"
 
 #include <iostream>
 #include <tweeny.h>
@@ -37,6 +38,18 @@ namespace glib
 		bool m_AutoAnimCenter;
 		Axis m_AutoAnimCenterAxis;
 		Vec2 m_AutoAnimCenterContainerSize;
+
+		// What the cached transform was computed from
+		bool m_TransformValid = false;
+		Vec2 m_TransformPos;
+		Vec2 m_TransformSize;
+		Vec2 m_TransformScale;
+		Vec2 m_TransformOffset;
+		float m_TransformRotation = 0.0f;
+		uint8_t m_TransformFlip = 0;
+		Affine2D m_WorldTransform;
+		Rect m_WorldBounds;
+		unsigned int m_TransformVersion = 0;
 	public:
 		SpriteImpl(Sprite* s) : m_Sprite(s), m_AnimationManager(this)
 		{
@@ -302,6 +315,60 @@ namespace glib
 		{
 			m_AutoAnimCenter = false;
 		}
+
+		uint8_t GetFlip() const
+		{
+			return (m_Sprite->flipX ? GLIB_AFFINE_FLIP_X : 0) | (m_Sprite->flipY ? GLIB_AFFINE_FLIP_Y : 0);
+		}
+
+		bool IsTransformDirty() const
+		{
+			const Sprite* s = m_Sprite;
+			return !m_TransformValid ||
+				s->pos.x != m_TransformPos.x || s->pos.y != m_TransformPos.y ||
+				s->size.x != m_TransformSize.x || s->size.y != m_TransformSize.y ||
+				s->scale.x != m_TransformScale.x || s->scale.y != m_TransformScale.y ||
+				s->offset.x != m_TransformOffset.x || s->offset.y != m_TransformOffset.y ||
+				s->rotation != m_TransformRotation || GetFlip() != m_TransformFlip;
+		}
+
+		void SetWorldTransform(const Affine2D& transform)
+		{
+			m_TransformValid = true;
+			m_TransformPos = m_Sprite->pos;
+			m_TransformSize = m_Sprite->size;
+			m_TransformScale = m_Sprite->scale;
+			m_TransformOffset = m_Sprite->offset;
+			m_TransformRotation = m_Sprite->rotation;
+			m_TransformFlip = GetFlip();
+			m_WorldTransform = transform;
+			m_WorldBounds = transform.GetQuadBounds();
+			m_TransformVersion++;
+		}
+
+		void UpdateTransform()
+		{
+			if (!IsTransformDirty()) return;
+			SetWorldTransform(MakeSpriteTransform(m_Sprite->pos, m_Sprite->size, m_Sprite->scale, m_Sprite->offset, Vec2(0.5f, 0.5f), m_Sprite->rotation, GetFlip()));
+		}
+
+		const Affine2D& GetWorldTransform()
+		{
+			UpdateTransform();
+			return m_WorldTransform;
+		}
+
+		const Rect& GetWorldBounds()
+		{
+			UpdateTransform();
+			return m_WorldBounds;
+		}
+
+		unsigned int GetTransformVersion()
+		{
+			UpdateTransform();
+			return m_TransformVersion;
+		}
 	};
 }
 
@@ -311,6 +378,7 @@ glib::Sprite::Sprite() : scale(Vec2(1.0f, 1.0f)), tex(nullptr), color({ 1.0f, 1.
 {
 	impl = new SpriteImpl(this);
 	visible = true;
+	kind = GLIB_DRAWABLE_SPRITE;
 }
 
 glib::Sprite::~Sprite()
@@ -357,6 +425,14 @@ void glib::Sprite::Update(float delta)
 	impl->Update(delta);
 }
 
+bool glib::Sprite::GetBounds(const Vec2& cameraPos, float zoom, Rect& bounds)
+{
+	// The camera scroll only moves the cached bounds
+	const Rect& world = impl->GetWorldBounds();
+	bounds = Rect(world.x - cameraPos.x * scrollFactor.x, world.y - cameraPos.y * scrollFactor.y, world.w, world.h);
+	return true;
+}
+
 void glib::Sprite::TweenPosition(const Vec2& to, float time, const Easing& easing, float delay)
 {
 	impl->TweenPosition(to, time, easing, delay);
@@ -456,3 +532,29 @@ const std::string& glib::Sprite::GetCurrentAnimationName() const
 {
 	return impl->GetCurrentAnimationName();
 }
+
+
+const Affine2D& glib::Sprite::GetWorldTransform()
+{
+	return impl->GetWorldTransform();
+}
+
+const Rect& glib::Sprite::GetWorldBounds()
+{
+	return impl->GetWorldBounds();
+}
+
+unsigned int glib::Sprite::GetTransformVersion()
+{
+	return impl->GetTransformVersion();
+}
+
+bool glib::Sprite::IsTransformDirty() const
+{
+	return impl->IsTransformDirty();
+}
+
+void glib::Sprite::SetWorldTransform(const Affine2D& transform)
+{
+	impl->SetWorldTransform(transform);
+}
\ No newline at end of file
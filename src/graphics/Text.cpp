@@ -1,7 +1,10 @@
 #include "glib/graphics/Text.h"
 
 #include <vector>
+#include <cmath>
 #include <tweeny.h>
+#include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 
 extern tweeny::easing::enumerated __translate_easing(glib::Easing easing);
 
@@ -29,6 +32,27 @@ namespace glib
 		float m_ScaleTweenDelay = 0.0f;
 		float m_RotationTweenDelay = 0.0f;
 		float m_ColorTweenDelay = 0.0f;
+
+		unsigned int m_MeshVAO = 0;
+		unsigned int m_MeshVBO = 0;
+		size_t m_MeshCapacity = 0;
+		std::vector<float> m_MeshVertices;
+		std::vector<TextMeshRange> m_MeshRanges;
+		bool m_MeshDirty = true;
+		Font* m_MeshFont = nullptr;
+		float m_MeshScale = 0.0f;
+		Vec2 m_MeshOffset;
+		float m_MeshRotation = 0.0f;
+		bool m_MeshUploadPending = false;
+		Rect m_MeshBounds;
+		unsigned int m_MeshVersion = 0;
+
+		// The mesh bounds moved to the position (see Text::GetWorldBounds)
+		bool m_TransformValid = false;
+		Vec2 m_TransformPos;
+		unsigned int m_TransformMeshVersion = 0;
+		Rect m_WorldBounds;
+		unsigned int m_TransformVersion = 0;
 	public:
 		TextImpl(Text* txt) : m_Txt(txt), m_AutoCenterToggle(false)
 		{
@@ -36,11 +60,17 @@ namespace glib
 
 		~TextImpl()
 		{
+			if (m_MeshVAO != 0)
+			{
+				OpenGLProxy::DeleteVertexArrays(1, &m_MeshVAO);
+				glDeleteBuffers(1, &m_MeshVBO);
+			}
 		}
 
 		void SetText(const std::wstring& text)
 		{
 			m_Text = text;
+			m_MeshDirty = true;
 			m_Txt->size = glib::Vec2(m_Txt->font->CalculateWidth(text, m_Txt->scale), m_Txt->font->CalculateHeight(text, m_Txt->scale));
 			if (m_AutoCenterToggle)
 			{
@@ -53,6 +83,174 @@ namespace glib
 			return m_Text;
 		}
 
+		void RebuildMesh()
+		{
+			if (m_Txt->font == nullptr) return;
+
+			if (!m_MeshDirty && m_MeshFont == m_Txt->font && m_MeshScale == m_Txt->scale && m_MeshRotation == m_Txt->rotation && m_MeshOffset.x == m_Txt->offset.x && m_MeshOffset.y == m_Txt->offset.y)
+			{
+				return;
+			}
+
+			m_MeshDirty = false;
+			m_MeshUploadPending = true;
+			m_MeshVersion++;
+			m_MeshFont = m_Txt->font;
+			m_MeshScale = m_Txt->scale;
+			m_MeshRotation = m_Txt->rotation;
+			m_MeshOffset = m_Txt->offset;
+
+			m_MeshVertices.clear();
+			m_MeshRanges.clear();
+
+			static const float corners[6][2] = {
+				{ 1.0f, 1.0f }, { 1.0f, 0.0f }, { 0.0f, 1.0f },
+				{ 1.0f, 0.0f }, { 0.0f, 0.0f }, { 0.0f, 1.0f }
+			};
+
+			// Same rotation as Mat4::Rotate (every glyph rotates around its own center)
+			float rad = m_MeshRotation * 3.14159265358979f / 180.0f;
+			float cs = std::cos(rad);
+			float sn = std::sin(rad);
+			float xOffset = 0.0f;
+
+			for (wchar_t c : m_Text)
+			{
+				const Glyph& glyph = m_MeshFont->GetGlyph(c);
+
+				float w = glyph.size.x * m_MeshScale;
+				float h = glyph.size.y * m_MeshScale;
+
+				if (w > 0.0f && h > 0.0f)
+				{
+					if (m_MeshRanges.empty() || m_MeshRanges.back().tex != glyph.tex)
+					{
+						m_MeshRanges.push_back({ glyph.tex, (int)(m_MeshVertices.size() / 4), 0 });
+					}
+
+					float cx = xOffset + glyph.bearing.x * m_MeshScale + m_MeshOffset.x + w / 2.0f;
+					float cy = -glyph.bearing.y * m_MeshScale + m_MeshOffset.y + h / 2.0f;
+
+					for (int i = 0; i < 6; i++)
+					{
+						float lx = corners[i][0] * w - w / 2.0f;
+						float ly = corners[i][1] * h - h / 2.0f;
+
+						m_MeshVertices.push_back(cx + lx * cs - ly * sn);
+						m_MeshVertices.push_back(cy + lx * sn + ly * cs);
+						m_MeshVertices.push_back(glyph.uvPos.x + corners[i][0] * glyph.uvSize.x);
+						m_MeshVertices.push_back(glyph.uvPos.y + corners[i][1] * glyph.uvSize.y);
+					}
+
+					m_MeshRanges.back().count += 6;
+				}
+
+				xOffset += (glyph.advance >> 6) * m_MeshScale;
+			}
+
+			float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+			for (size_t i = 0; i < m_MeshVertices.size(); i += 4)
+			{
+				float x = m_MeshVertices[i];
+				float y = m_MeshVertices[i + 1];
+				if (i == 0 || x < minX) minX = x;
+				if (i == 0 || y < minY) minY = y;
+				if (i == 0 || x > maxX) maxX = x;
+				if (i == 0 || y > maxY) maxY = y;
+			}
+			m_MeshBounds = Rect(minX, minY, maxX - minX, maxY - minY);
+		}
+
+		void UpdateMesh()
+		{
+			RebuildMesh();
+			if (!m_MeshUploadPending) return;
+			m_MeshUploadPending = false;
+
+			if (m_MeshVAO == 0)
+			{
+				glGenVertexArrays(1, &m_MeshVAO);
+				glGenBuffers(1, &m_MeshVBO);
+
+				OpenGLProxy::BindVertexArray(m_MeshVAO);
+				glBindBuffer(GL_ARRAY_BUFFER, m_MeshVBO);
+
+				glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+				glEnableVertexAttribArray(0);
+
+				glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+				glEnableVertexAttribArray(1);
+
+				OpenGLProxy::BindVertexArray(0);
+			}
+
+			glBindBuffer(GL_ARRAY_BUFFER, m_MeshVBO);
+			if (m_MeshVertices.size() > m_MeshCapacity)
+			{
+				m_MeshCapacity = m_MeshVertices.size();
+				glBufferData(GL_ARRAY_BUFFER, sizeof(float) * m_MeshCapacity, m_MeshVertices.data(), GL_DYNAMIC_DRAW);
+			}
+			else if (!m_MeshVertices.empty())
+			{
+				glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(float) * m_MeshVertices.size(), m_MeshVertices.data());
+			}
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+
+		bool GetBounds(const Vec2& cameraPos, float zoom, Rect& bounds)
+		{
+			if (m_Txt->font == nullptr) return false;
+			UpdateTransform();
+
+			// Same offset as CameraRenderer::DrawText
+			bounds = Rect(m_WorldBounds.x - cameraPos.x * zoom, m_WorldBounds.y - cameraPos.y * zoom, m_WorldBounds.w, m_WorldBounds.h);
+			return true;
+		}
+
+		void UpdateTransform()
+		{
+			RebuildMesh();
+
+			if (m_TransformValid && m_TransformMeshVersion == m_MeshVersion && m_TransformPos.x == m_Txt->pos.x && m_TransformPos.y == m_Txt->pos.y)
+			{
+				return;
+			}
+
+			m_TransformValid = true;
+			m_TransformMeshVersion = m_MeshVersion;
+			m_TransformPos = m_Txt->pos;
+			m_WorldBounds = Rect(m_TransformPos.x + m_MeshBounds.x, m_TransformPos.y + m_MeshBounds.y, m_MeshBounds.w, m_MeshBounds.h);
+			m_TransformVersion++;
+		}
+
+		const Rect& GetWorldBounds()
+		{
+			UpdateTransform();
+			return m_WorldBounds;
+		}
+
+		unsigned int GetTransformVersion()
+		{
+			UpdateTransform();
+			return m_TransformVersion;
+		}
+
+		const std::vector<float>& GetMeshVertices()
+		{
+			RebuildMesh();
+			return m_MeshVertices;
+		}
+
+		unsigned int GetMeshVAO()
+		{
+			return m_MeshVAO;
+		}
+
+		const std::vector<TextMeshRange>& GetMeshRanges()
+		{
+			return m_MeshRanges;
+		}
+
 		void SetAutoCenter(bool toggle, Axis axis, const Vec2& containerSize)
 		{
 			m_AutoCenterToggle = toggle;
@@ -175,6 +373,7 @@ using namespace glib;
 glib::Text::Text() : scale(1.0f), font(nullptr), color({ 1.0f, 1.0f, 1.0f, 1.0f }), xFlip(false), yFlip(false), rotation(0.0f)
 {
 	visible = true;
+	kind = GLIB_DRAWABLE_TEXT;
 	impl = new TextImpl(this);
 }
 
@@ -225,6 +424,31 @@ const std::wstring& glib::Text::GetText()
 	return impl->GetText();
 }
 
+void glib::Text::UpdateMesh()
+{
+	impl->UpdateMesh();
+}
+
+unsigned int glib::Text::GetMeshVAO()
+{
+	return impl->GetMeshVAO();
+}
+
+const std::vector<TextMeshRange>& glib::Text::GetMeshRanges()
+{
+	return impl->GetMeshRanges();
+}
+
+const std::vector<float>& glib::Text::GetMeshVertices()
+{
+	return impl->GetMeshVertices();
+}
+
+bool glib::Text::GetBounds(const Vec2& cameraPos, float zoom, Rect& bounds)
+{
+	return impl->GetBounds(cameraPos, zoom, bounds);
+}
+
 void glib::Text::SetAutoCenter(bool toggle, Axis axis, const Vec2& containerSize)
 {
 	impl->SetAutoCenter(toggle, axis, containerSize);
@@ -249,3 +473,14 @@ void glib::Text::TweenColor(const Color& to, float time, const Easing& easing, f
 {
 	impl->TweenColor(to, time, easing, delay);
 }
+
+
+const Rect& glib::Text::GetWorldBounds()
+{
+	return impl->GetWorldBounds();
+}
+
+unsigned int glib::Text::GetTransformVersion()
+{
+	return impl->GetTransformVersion();
+}
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "glib/graphics/Texture.h"
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 #include <iostream>
 
 namespace glib
@@ -9,25 +10,27 @@ namespace glib
 	private:
 		unsigned int m_ID;
 		bool m_DeleteID = true;
+		Vec2 m_UVOffset;
+		Vec2 m_UVSize;
 	public:
-		TextureImpl(unsigned int id) : m_ID(id)
+		TextureImpl(unsigned int id, const Vec2& uvOffset, const Vec2& uvSize) : m_ID(id), m_UVOffset(uvOffset), m_UVSize(uvSize)
 		{
 		}
 
 		~TextureImpl()
 		{
 			if (!m_DeleteID) return;
-			glDeleteTextures(1, &m_ID);
+			OpenGLProxy::DeleteTextures(1, &m_ID);
 		}
 
 		void Bind()
 		{
-			glBindTexture(GL_TEXTURE_2D, m_ID);
+			OpenGLProxy::BindTexture(GL_TEXTURE_2D, m_ID);
 		}
 
 		void Unbind()
 		{
-			glBindTexture(GL_TEXTURE_2D, 0);
+			OpenGLProxy::BindTexture(GL_TEXTURE_2D, 0);
 		}
 
 		unsigned int GetID()
@@ -39,6 +42,21 @@ namespace glib
 		{
 			m_DeleteID = deleteID;
 		}
+
+		const Vec2& GetUVOffset() const
+		{
+			return m_UVOffset;
+		}
+
+		const Vec2& GetUVSize() const
+		{
+			return m_UVSize;
+		}
+
+		bool IsAtlasRegion() const
+		{
+			return m_UVOffset.x != 0.0f || m_UVOffset.y != 0.0f || m_UVSize.x != 1.0f || m_UVSize.y != 1.0f;
+		}
 	};
 }
 
@@ -46,7 +64,12 @@ using namespace glib;
 
 glib::Texture::Texture(unsigned int id, int width, int height) : width(width), height(height)
 {
-	impl = new TextureImpl(id);
+	impl = new TextureImpl(id, Vec2(0.0f, 0.0f), Vec2(1.0f, 1.0f));
+}
+
+glib::Texture::Texture(unsigned int id, int width, int height, const Vec2& uvOffset, const Vec2& uvSize) : width(width), height(height)
+{
+	impl = new TextureImpl(id, uvOffset, uvSize);
 }
 
 glib::Texture::~Texture()
@@ -73,3 +96,18 @@ void glib::Texture::SetDeleteID(bool deleteID)
 {
 	impl->SetDeleteID(deleteID);
 }
+
+const Vec2& glib::Texture::GetUVOffset() const
+{
+	return impl->GetUVOffset();
+}
+
+const Vec2& glib::Texture::GetUVSize() const
+{
+	return impl->GetUVSize();
+}
+
+bool glib::Texture::IsAtlasRegion() const
+{
+	return impl->IsAtlasRegion();
+}
@@ -0,0 +1,156 @@
+#include "glib/graphics/TextureAtlas.h"
+#include "glib/graphics/AtlasPacker.h"
+
+#include <vector>
+#include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
+
+namespace glib
+{
+	class TextureAtlasImpl
+	{
+	private:
+		struct Page
+		{
+			unsigned int id;
+			AtlasPacker* packer;
+		};
+	private:
+		int m_PageSize;
+		bool m_Pixelart;
+		int m_Padding;
+		std::vector<Page> m_Pages;
+		std::vector<unsigned char> m_Padded; // Kept between calls, so adding images doesn't allocate every time
+	public:
+		TextureAtlasImpl(int pageSize, bool pixelart, int padding) : m_PageSize(pageSize), m_Pixelart(pixelart), m_Padding(padding)
+		{
+		}
+
+		~TextureAtlasImpl()
+		{
+			for (Page& page : m_Pages)
+			{
+				OpenGLProxy::DeleteTextures(1, &page.id);
+				delete page.packer;
+			}
+		}
+
+		Texture* Add(const ImageData& data)
+		{
+			int w = data.width + m_Padding * 2;
+			int h = data.height + m_Padding * 2;
+
+			if (w > m_PageSize || h > m_PageSize) return nullptr;
+
+			Vec2i pos;
+			Page* page = nullptr;
+
+			for (Page& p : m_Pages)
+			{
+				if (p.packer->Pack(w, h, pos))
+				{
+					page = &p;
+					break;
+				}
+			}
+
+			if (page == nullptr)
+			{
+				page = &NewPage();
+				page->packer->Pack(w, h, pos);
+			}
+
+			int x = pos.x + m_Padding;
+			int y = pos.y + m_Padding;
+
+			// The padding repeats the edge pixels, so linear filtering at the border samples the image itself (like GL_CLAMP_TO_EDGE)
+			m_Padded.resize((size_t)w * h * 4);
+			for (int py = 0; py < h; py++)
+			{
+				int sy = py - m_Padding;
+				sy = sy < 0 ? 0 : (sy >= data.height ? data.height - 1 : sy);
+
+				for (int px = 0; px < w; px++)
+				{
+					int sx = px - m_Padding;
+					sx = sx < 0 ? 0 : (sx >= data.width ? data.width - 1 : sx);
+
+					const unsigned char* src = data.data + ((size_t)sy * data.width + sx) * 4;
+					unsigned char* dst = m_Padded.data() + ((size_t)py * w + px) * 4;
+					dst[0] = src[0];
+					dst[1] = src[1];
+					dst[2] = src[2];
+					dst[3] = src[3];
+				}
+			}
+
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+			OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+			OpenGLProxy::BindTexture(GL_TEXTURE_2D, page->id);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, w, h, GL_RGBA, GL_UNSIGNED_BYTE, m_Padded.data());
+			OpenGLProxy::BindTexture(GL_TEXTURE_2D, 0);
+
+			float size = (float)m_PageSize;
+			Texture* tex = new Texture(page->id, data.width, data.height, Vec2(x / size, y / size), Vec2(data.width / size, data.height / size));
+			tex->SetDeleteID(false); // The page is owned by the atlas
+			return tex;
+		}
+
+		size_t GetPageCount() const
+		{
+			return m_Pages.size();
+		}
+	private:
+		Page& NewPage()
+		{
+			unsigned int id;
+			glGenTextures(1, &id);
+			OpenGLProxy::BindTexture(GL_TEXTURE_2D, id);
+
+			if (m_Pixelart)
+			{
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+			}
+			else
+			{
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			}
+
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+			// Start fully transparent, so unused space never shows up
+			std::vector<unsigned char> empty((size_t)m_PageSize * m_PageSize * 4, 0);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, m_PageSize, m_PageSize, 0, GL_RGBA, GL_UNSIGNED_BYTE, empty.data());
+
+			OpenGLProxy::BindTexture(GL_TEXTURE_2D, 0);
+
+			m_Pages.push_back({ id, new AtlasPacker(m_PageSize, m_PageSize) });
+			return m_Pages.back();
+		}
+	};
+}
+
+using namespace glib;
+
+glib::TextureAtlas::TextureAtlas(int pageSize, bool pixelart, int padding)
+{
+	impl = new TextureAtlasImpl(pageSize, pixelart, padding);
+}
+
+glib::TextureAtlas::~TextureAtlas()
+{
+	delete impl;
+}
+
+Texture* glib::TextureAtlas::Add(const ImageData& data)
+{
+	return impl->Add(data);
+}
+
+size_t glib::TextureAtlas::GetPageCount() const
+{
+	return impl->GetPageCount();
+}
\ No newline at end of file
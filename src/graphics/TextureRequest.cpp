@@ -0,0 +1,110 @@
+#include "glib/graphics/TextureRequest.h"
+
+#include <atomic>
+
+namespace glib
+{
+	class TextureRequestImpl
+	{
+	private:
+		std::string m_Path;
+		std::atomic<TextureLoadState> m_State;
+		std::atomic<float> m_Progress;
+		std::atomic<Texture*> m_Texture;
+	public:
+		TextureRequestImpl(const std::string& path) : m_Path(path), m_State(TextureLoadState::Decoding), m_Progress(0.0f), m_Texture(nullptr)
+		{
+		}
+
+		TextureLoadState GetState() const
+		{
+			return m_State.load();
+		}
+
+		Texture* GetTexture() const
+		{
+			return m_Texture.load();
+		}
+
+		float GetProgress() const
+		{
+			return m_Progress.load();
+		}
+
+		const std::string& GetPath() const
+		{
+			return m_Path;
+		}
+
+		void SetProgress(float progress)
+		{
+			m_Progress.store(progress);
+		}
+
+		void Finish(Texture* texture)
+		{
+			// The texture is published before the state, so Done always comes with a texture
+			m_Texture.store(texture);
+			if (texture != nullptr) m_Progress.store(1.0f);
+			m_State.store(texture != nullptr ? TextureLoadState::Done : TextureLoadState::Failed);
+		}
+
+		void SetUploading()
+		{
+			m_State.store(TextureLoadState::Uploading);
+		}
+	};
+}
+
+using namespace glib;
+
+glib::TextureRequest::TextureRequest(const std::string& path)
+{
+	impl = new TextureRequestImpl(path);
+}
+
+glib::TextureRequest::~TextureRequest()
+{
+	delete impl;
+}
+
+TextureLoadState glib::TextureRequest::GetState() const
+{
+	return impl->GetState();
+}
+
+bool glib::TextureRequest::IsDone() const
+{
+	TextureLoadState state = impl->GetState();
+	return state == TextureLoadState::Done || state == TextureLoadState::Failed;
+}
+
+Texture* glib::TextureRequest::GetTexture() const
+{
+	return impl->GetTexture();
+}
+
+float glib::TextureRequest::GetProgress() const
+{
+	return impl->GetProgress();
+}
+
+const std::string& glib::TextureRequest::GetPath() const
+{
+	return impl->GetPath();
+}
+
+void glib::TextureRequest::SetProgress(float progress)
+{
+	impl->SetProgress(progress);
+}
+
+void glib::TextureRequest::Finish(Texture* texture)
+{
+	impl->Finish(texture);
+}
+
+void glib::TextureRequest::SetUploading()
+{
+	impl->SetUploading();
+}
\ No newline at end of file
@@ -1,6 +1,12 @@
 #include "glib/graphics/camera/Camera.h"
+#include "glib/graphics/camera/SpatialHash.h"
+#include "glib/graphics/Sprite.h"
+#include "glib/graphics/Text.h"
 
 #include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cmath>
 #include <tweeny.h>
 #include <iostream>
 
@@ -20,23 +26,38 @@ namespace glib
 		tweeny::tween<float> m_RotTween;
 		bool m_RotTweenActive = false;
 		Vec2 m_InitialSize;
+		bool m_Culling;
+		CullStats m_CullStats;
+		std::vector<Drawable*> m_Visible;
+		SpatialHash* m_Hash;
+		std::vector<SpatialHashEntry> m_Dynamic;
+		std::vector<SpatialHashEntry> m_Candidates;
+		std::vector<Drawable*> m_Unhashed;
+		std::unordered_map<Drawable*, uint64_t> m_Orders;
+		uint64_t m_NextOrder;
+		bool m_Retained;
 	public:
-		CameraImpl(Camera* camera, Vec2 initialSize) : m_Camera(camera), m_InitialSize(initialSize)
+		CameraImpl(Camera* camera, Vec2 initialSize) : m_Camera(camera), m_InitialSize(initialSize), m_Culling(true), m_Hash(nullptr), m_NextOrder(0), m_Retained(false)
 		{
 		}
 
 		~CameraImpl()
 		{
+			delete m_Hash;
 		}
 
 		void Add(Drawable* drawable)
 		{
 			m_Drawables.push_back(drawable);
+			if (m_Hash != nullptr)
+			{
+				Track(drawable, m_NextOrder++);
+			}
 		}
 
 		void Add(Drawable& drawable)
 		{
-			m_Drawables.push_back(&drawable);
+			Add(&drawable);
 		}
 
 		void Remove(Drawable* drawable)
@@ -44,6 +65,11 @@ namespace glib
 			std::vector<Drawable*>::iterator it = std::find(m_Drawables.begin(), m_Drawables.end(), drawable);
 			if (it == m_Drawables.end()) return;
 			m_Drawables.erase(it);
+
+			if (m_Hash != nullptr)
+			{
+				Untrack(drawable);
+			}
 		}
 
 		std::vector<Drawable*>& GetDrawables()
@@ -54,7 +80,283 @@ namespace glib
 		void RemoveAll()
 		{
 			m_Drawables.clear();
+
+			if (m_Hash != nullptr)
+			{
+				m_Hash->Clear();
+				m_Dynamic.clear();
+				m_Orders.clear();
+			}
+		}
+
+		Rect CalculateViewRect()
+		{
+			float zoom = m_Camera->zoom;
+			if (zoom <= 0.0f)
+			{
+				// Nothing sensible is visible, so don't cull anything
+				return Rect(-1e30f, -1e30f, 2e30f, 2e30f);
+			}
+
+			// Inverse of CalculateView applied to the corners of the screen
+			Vec2 pivot = Vec2(m_InitialSize.x / 2.0f * zoom, m_InitialSize.y / 2.0f * zoom);
+			Vec2 half = Vec2((m_InitialSize.x * zoom - m_InitialSize.x) / 2.0f, (m_InitialSize.y * zoom - m_InitialSize.y) / 2.0f);
+
+			float rad = -m_Camera->rotation * 3.14159265358979f / 180.0f;
+			float c = std::cos(rad);
+			float s = std::sin(rad);
+
+			float corners[4][2] = {
+				{ 0.0f, 0.0f },
+				{ m_InitialSize.x, 0.0f },
+				{ m_InitialSize.x, m_InitialSize.y },
+				{ 0.0f, m_InitialSize.y }
+			};
+
+			float minX = 0.0f, minY = 0.0f, maxX = 0.0f, maxY = 0.0f;
+			for (int i = 0; i < 4; i++)
+			{
+				float x = corners[i][0] - pivot.x;
+				float y = corners[i][1] - pivot.y;
+				float px = (pivot.x + x * c - y * s + half.x) / zoom;
+				float py = (pivot.y + x * s + y * c + half.y) / zoom;
+
+				if (i == 0)
+				{
+					minX = maxX = px;
+					minY = maxY = py;
+					continue;
+				}
+
+				minX = std::min(minX, px);
+				minY = std::min(minY, py);
+				maxX = std::max(maxX, px);
+				maxY = std::max(maxY, py);
+			}
+
+			return Rect(minX, minY, maxX - minX, maxY - minY);
+		}
+
+		void SetCulling(bool toggle)
+		{
+			m_Culling = toggle;
+		}
+
+		bool IsCulling() const
+		{
+			return m_Culling;
+		}
+
+		void SetSpatialHashing(bool toggle, float cellSize)
+		{
+			delete m_Hash;
+			m_Hash = nullptr;
+			m_Dynamic.clear();
+			m_Orders.clear();
+			m_NextOrder = 0;
+
+			if (!toggle) return;
+
+			m_Hash = new SpatialHash(cellSize);
+			for (Drawable* drawable : m_Drawables)
+			{
+				Track(drawable, m_NextOrder++);
+			}
+		}
+
+		void RefreshStatic(Drawable* drawable)
+		{
+			if (m_Hash == nullptr) return;
+
+			auto it = m_Orders.find(drawable);
+			if (it == m_Orders.end()) return;
+
+			uint64_t order = it->second;
+			Untrack(drawable);
+			Track(drawable, order);
+		}
+
+		const CullStats& GetCullStats() const
+		{
+			return m_CullStats;
+		}
+
+		void SetRetained(bool toggle)
+		{
+			m_Retained = toggle;
+		}
+
+		bool IsRetained() const
+		{
+			return m_Retained;
+		}
+
+		bool CalculateSignature(uint64_t& signature)
+		{
+			// FNV-1a over the camera and the state of everything it draws. The drawable pointers cover adding, removing and reordering
+			uint64_t hash = 14695981039346656037ull;
+			auto mix = [&hash](const void* data, size_t size)
+			{
+				const unsigned char* bytes = (const unsigned char*)data;
+				for (size_t i = 0; i < size; i++)
+				{
+					hash ^= bytes[i];
+					hash *= 1099511628211ull;
+				}
+			};
+
+			mix(&m_Camera->pos, sizeof(Vec2));
+			mix(&m_Camera->zoom, sizeof(float));
+			mix(&m_Camera->rotation, sizeof(float));
+
+			for (Drawable* drawable : m_Drawables)
+			{
+				mix(&drawable, sizeof(Drawable*));
+				mix(&drawable->visible, sizeof(bool));
+				mix(&drawable->layer, sizeof(int));
+				if (!drawable->visible) continue;
+
+				if (drawable->kind == GLIB_DRAWABLE_SPRITE)
+				{
+					Sprite* sprite = static_cast<Sprite*>(drawable);
+					unsigned int version = sprite->GetTransformVersion();
+					mix(&version, sizeof(unsigned int));
+					mix(&sprite->color, sizeof(Color));
+					mix(&sprite->tex, sizeof(Texture*));
+					mix(&sprite->textureOffset, sizeof(Vec2));
+					mix(&sprite->textureSize, sizeof(Vec2));
+					mix(&sprite->scrollFactor, sizeof(Vec2));
+				}
+				else if (drawable->kind == GLIB_DRAWABLE_TEXT)
+				{
+					// The version covers the text, font, scale, offset, rotation and position
+					Text* text = static_cast<Text*>(drawable);
+					unsigned int version = text->GetTransformVersion();
+					mix(&version, sizeof(unsigned int));
+					mix(&text->color, sizeof(Color));
+					mix(&text->xFlip, sizeof(bool));
+					mix(&text->yFlip, sizeof(bool));
+				}
+				else
+				{
+					return false;
+				}
+			}
+
+			signature = hash;
+			return true;
+		}
+
+		const std::vector<Drawable*>& GetUnhashedDrawables()
+		{
+			if (m_Hash == nullptr) return m_Drawables;
+
+			m_Unhashed.clear();
+			for (const SpatialHashEntry& entry : m_Dynamic)
+			{
+				m_Unhashed.push_back(entry.drawable);
+			}
+			return m_Unhashed;
+		}
+
+		const std::vector<Drawable*>& GatherVisible()
+		{
+			m_Visible.clear();
+			m_CullStats = CullStats();
+
+			// Without a usable zoom the view is unbounded (see CalculateViewRect), so neither the bounds nor the hash can exclude anything
+			if (!m_Culling || m_Camera->zoom <= 0.0f)
+			{
+				for (Drawable* drawable : m_Drawables)
+				{
+					if (drawable->visible) m_Visible.push_back(drawable);
+				}
+				m_CullStats.submitted = (unsigned int)m_Visible.size();
+				return m_Visible;
+			}
+
+			Rect view = CalculateViewRect();
+			const Vec2& cameraPos = m_Camera->pos;
+			float zoom = m_Camera->zoom;
+			Rect bounds;
+
+			if (m_Hash == nullptr)
+			{
+				for (Drawable* drawable : m_Drawables)
+				{
+					if (!drawable->visible) continue;
+					if (drawable->GetBounds(cameraPos, zoom, bounds) && !bounds.Overlaps(view))
+					{
+						m_CullStats.culled++;
+						continue;
+					}
+					m_Visible.push_back(drawable);
+				}
+				m_CullStats.submitted = (unsigned int)m_Visible.size();
+				return m_Visible;
+			}
+
+			// Hashed drawables are stored in world space, the view moves with the camera
+			m_Candidates.clear();
+			m_Hash->Query(Rect(view.x + cameraPos.x, view.y + cameraPos.y, view.w, view.h), m_Candidates);
+			m_CullStats.culled += (unsigned int)(m_Hash->GetCount() - m_Candidates.size());
+
+			for (const SpatialHashEntry& entry : m_Dynamic)
+			{
+				if (!entry.drawable->visible) continue;
+				if (entry.drawable->GetBounds(cameraPos, zoom, bounds) && !bounds.Overlaps(view))
+				{
+					m_CullStats.culled++;
+					continue;
+				}
+				m_Candidates.push_back(entry);
+			}
+
+			std::sort(m_Candidates.begin(), m_Candidates.end(), [](const SpatialHashEntry& a, const SpatialHashEntry& b) {
+				return a.order < b.order;
+			});
+
+			for (const SpatialHashEntry& entry : m_Candidates)
+			{
+				if (entry.drawable->visible) m_Visible.push_back(entry.drawable);
+			}
+			m_CullStats.submitted = (unsigned int)m_Visible.size();
+			return m_Visible;
+		}
+	private:
+		void Track(Drawable* drawable, uint64_t order)
+		{
+			m_Orders[drawable] = order;
+
+			// Only sprites that scroll 1:1 with the camera can be looked up by a world position
+			Rect bounds;
+			if (drawable->isStatic && drawable->kind == GLIB_DRAWABLE_SPRITE)
+			{
+				Sprite* sprite = static_cast<Sprite*>(drawable);
+				if (sprite->scrollFactor.x == 1.0f && sprite->scrollFactor.y == 1.0f && sprite->GetBounds(Vec2(0.0f, 0.0f), 1.0f, bounds))
+				{
+					m_Hash->Insert(drawable, bounds, order);
+					return;
+				}
+			}
+
+			m_Dynamic.push_back({ drawable, Rect(), order });
+		}
+
+		void Untrack(Drawable* drawable)
+		{
+			m_Orders.erase(drawable);
+			m_Hash->Remove(drawable);
+			for (size_t i = 0; i < m_Dynamic.size(); i++)
+			{
+				if (m_Dynamic[i].drawable == drawable)
+				{
+					m_Dynamic.erase(m_Dynamic.begin() + i);
+					break;
+				}
+			}
 		}
+	public:
 
 		void Update(float delta)
 		{
@@ -181,6 +483,61 @@ Mat4 glib::Camera::CalculateView()
 	return impl->CalculateView();
 }
 
+Rect glib::Camera::CalculateViewRect()
+{
+	return impl->CalculateViewRect();
+}
+
+void glib::Camera::SetCulling(bool toggle)
+{
+	impl->SetCulling(toggle);
+}
+
+bool glib::Camera::IsCulling() const
+{
+	return impl->IsCulling();
+}
+
+void glib::Camera::SetSpatialHashing(bool toggle, float cellSize)
+{
+	impl->SetSpatialHashing(toggle, cellSize);
+}
+
+void glib::Camera::RefreshStatic(Drawable* drawable)
+{
+	impl->RefreshStatic(drawable);
+}
+
+const CullStats& glib::Camera::GetCullStats() const
+{
+	return impl->GetCullStats();
+}
+
+void glib::Camera::SetRetained(bool toggle)
+{
+	impl->SetRetained(toggle);
+}
+
+bool glib::Camera::IsRetained() const
+{
+	return impl->IsRetained();
+}
+
+const std::vector<Drawable*>& glib::Camera::GatherVisible()
+{
+	return impl->GatherVisible();
+}
+
+const std::vector<Drawable*>& glib::Camera::GetUnhashedDrawables()
+{
+	return impl->GetUnhashedDrawables();
+}
+
+bool glib::Camera::CalculateSignature(uint64_t& signature)
+{
+	return impl->CalculateSignature(signature);
+}
+
 void glib::Camera::Update(float delta)
 {
 	impl->Update(delta);
@@ -0,0 +1,251 @@
+#include "glib/graphics/camera/SpatialHash.h"
+
+#include <unordered_map>
+#include <cmath>
+
+#define CELL_LIMIT 0x3FFFFFFF // Cell coordinates are clamped to this, so huge or infinite rects can't overflow an int
+
+namespace glib
+{
+	class SpatialHashImpl
+	{
+	private:
+		struct Entry
+		{
+			SpatialHashEntry data;
+			int minX;
+			int minY;
+			int maxX;
+			int maxY;
+			unsigned int stamp;
+			bool used;
+		};
+	private:
+		float m_CellSize;
+		std::vector<Entry> m_Entries;
+		std::vector<size_t> m_Free;
+		std::unordered_map<Drawable*, size_t> m_Indices;
+		std::unordered_map<long long, std::vector<size_t>> m_Cells;
+		unsigned int m_Stamp;
+	public:
+		SpatialHashImpl(float cellSize) : m_CellSize(cellSize > 0.0f ? cellSize : 512.0f), m_Stamp(0)
+		{
+		}
+
+		void Insert(Drawable* drawable, const Rect& bounds, uint64_t order)
+		{
+			int minX, minY, maxX, maxY;
+			CellRange(bounds, minX, minY, maxX, maxY);
+
+			auto it = m_Indices.find(drawable);
+			if (it != m_Indices.end())
+			{
+				Entry& entry = m_Entries[it->second];
+				entry.data.bounds = bounds;
+				entry.data.order = order;
+				if (entry.minX == minX && entry.minY == minY && entry.maxX == maxX && entry.maxY == maxY) return;
+
+				// Moved into other cells
+				Unlink(it->second);
+				entry.minX = minX;
+				entry.minY = minY;
+				entry.maxX = maxX;
+				entry.maxY = maxY;
+				Link(it->second);
+				return;
+			}
+
+			size_t index;
+			if (!m_Free.empty())
+			{
+				index = m_Free.back();
+				m_Free.pop_back();
+			}
+			else
+			{
+				index = m_Entries.size();
+				m_Entries.push_back({});
+			}
+
+			m_Entries[index] = { { drawable, bounds, order }, minX, minY, maxX, maxY, 0, true };
+			m_Indices.insert({ drawable, index });
+			Link(index);
+		}
+
+		void Remove(Drawable* drawable)
+		{
+			auto it = m_Indices.find(drawable);
+			if (it == m_Indices.end()) return;
+
+			Unlink(it->second);
+			m_Entries[it->second].used = false;
+			m_Free.push_back(it->second);
+			m_Indices.erase(it);
+		}
+
+		void Clear()
+		{
+			m_Entries.clear();
+			m_Free.clear();
+			m_Indices.clear();
+			m_Cells.clear();
+		}
+
+		void Query(const Rect& area, std::vector<SpatialHashEntry>& out)
+		{
+			int minX, minY, maxX, maxY;
+			CellRange(area, minX, minY, maxX, maxY);
+
+			m_Stamp++;
+
+			// When zoomed out far the area covers more cells than there are drawables, so just test all of them
+			long long cellCount = ((long long)maxX - minX + 1) * ((long long)maxY - minY + 1);
+			if (cellCount > (long long)m_Indices.size())
+			{
+				for (Entry& entry : m_Entries)
+				{
+					if (entry.used && entry.data.bounds.Overlaps(area))
+					{
+						out.push_back(entry.data);
+					}
+				}
+				return;
+			}
+
+			for (int y = minY; y <= maxY; y++)
+			{
+				for (int x = minX; x <= maxX; x++)
+				{
+					auto cell = m_Cells.find(Key(x, y));
+					if (cell == m_Cells.end()) continue;
+
+					for (size_t index : cell->second)
+					{
+						Entry& entry = m_Entries[index];
+						if (entry.stamp == m_Stamp) continue;
+						entry.stamp = m_Stamp;
+
+						if (entry.data.bounds.Overlaps(area))
+						{
+							out.push_back(entry.data);
+						}
+					}
+				}
+			}
+		}
+
+		size_t GetCount() const
+		{
+			return m_Indices.size();
+		}
+
+		float GetCellSize() const
+		{
+			return m_CellSize;
+		}
+	private:
+		static long long Key(int x, int y)
+		{
+			return ((long long)x << 32) ^ (long long)(unsigned int)y;
+		}
+
+		static int ToCell(float v)
+		{
+			v = std::floor(v);
+			if (!(v > (float)-CELL_LIMIT)) return -CELL_LIMIT; // Also catches NaN
+			if (v > (float)CELL_LIMIT) return CELL_LIMIT;
+			return (int)v;
+		}
+
+		void CellRange(const Rect& rect, int& minX, int& minY, int& maxX, int& maxY) const
+		{
+			minX = ToCell(rect.x / m_CellSize);
+			minY = ToCell(rect.y / m_CellSize);
+			maxX = ToCell((rect.x + rect.w) / m_CellSize);
+			maxY = ToCell((rect.y + rect.h) / m_CellSize);
+		}
+
+		void Link(size_t index)
+		{
+			Entry& entry = m_Entries[index];
+			for (int y = entry.minY; y <= entry.maxY; y++)
+			{
+				for (int x = entry.minX; x <= entry.maxX; x++)
+				{
+					m_Cells[Key(x, y)].push_back(index);
+				}
+			}
+		}
+
+		void Unlink(size_t index)
+		{
+			Entry& entry = m_Entries[index];
+			for (int y = entry.minY; y <= entry.maxY; y++)
+			{
+				for (int x = entry.minX; x <= entry.maxX; x++)
+				{
+					auto cell = m_Cells.find(Key(x, y));
+					if (cell == m_Cells.end()) continue;
+
+					std::vector<size_t>& indices = cell->second;
+					for (size_t i = 0; i < indices.size(); i++)
+					{
+						if (indices[i] == index)
+						{
+							indices[i] = indices.back();
+							indices.pop_back();
+							break;
+						}
+					}
+
+					if (indices.empty())
+					{
+						m_Cells.erase(cell);
+					}
+				}
+			}
+		}
+	};
+}
+
+using namespace glib;
+
+glib::SpatialHash::SpatialHash(float cellSize)
+{
+	impl = new SpatialHashImpl(cellSize);
+}
+
+glib::SpatialHash::~SpatialHash()
+{
+	delete impl;
+}
+
+void glib::SpatialHash::Insert(Drawable* drawable, const Rect& bounds, uint64_t order)
+{
+	impl->Insert(drawable, bounds, order);
+}
+
+void glib::SpatialHash::Remove(Drawable* drawable)
+{
+	impl->Remove(drawable);
+}
+
+void glib::SpatialHash::Clear()
+{
+	impl->Clear();
+}
+
+void glib::SpatialHash::Query(const Rect& area, std::vector<SpatialHashEntry>& out)
+{
+	impl->Query(area, out);
+}
+
+size_t glib::SpatialHash::GetCount() const
+{
+	return impl->GetCount();
+}
+
+float glib::SpatialHash::GetCellSize() const
+{
+	return impl->GetCellSize();
+}
\ No newline at end of file
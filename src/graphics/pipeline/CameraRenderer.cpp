@@ -7,9 +7,29 @@
 
 #include <memory>
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
+#include "glib/math/Affine2D.h"
+#include "glib/backend/StreamBuffer.h"
+#include "glib/utils/ThreadPool.h"
+
+#define PACKET_TEXT_STREAM_SIZE (4 * 1024 * 1024)
+#define PARALLEL_MIN_SPRITES 1024 // Shorter runs aren't worth waking up the workers for
+#define PARALLEL_CHUNK 256
 
 using namespace glib;
 
+static void UseShader(Shader* shader, Shader*& current)
+{
+	if (shader == current) return;
+	shader->Use();
+	current = shader;
+}
+
+static uint8_t SpriteFlip(const Sprite* s)
+{
+	return (s->flipX ? GLIB_AFFINE_FLIP_X : 0) | (s->flipY ? GLIB_AFFINE_FLIP_Y : 0);
+}
+
 static const char* VERTEX_SHADER = R"(
 #version 330 core
 
@@ -63,225 +83,623 @@ void main()
 }
 )";
 
-glib::CameraRenderer::CameraRenderer() : glib::PipelineRenderer(VERTEX_SHADER, FRAGMENT_SHADER)
+static const char* BATCH_VERTEX_SHADER = R"(
+#version 330 core
+
+layout(location = 0) in vec2 pos;
+layout(location = 1) in vec2 _texCoord;
+layout(location = 2) in vec4 _color;
+
+out vec2 glib_uv;
+out vec4 glib_color;
+
+uniform mat4 glib_projection_matrix;
+uniform mat4 glib_view_matrix;
+
+void main()
 {
+	gl_Position = glib_projection_matrix * glib_view_matrix * vec4(pos, 0.0, 1.0);
+	glib_uv = _texCoord;
+	glib_color = _color;
 }
+)";
 
-glib::CameraRenderer::~CameraRenderer()
+static const char* BATCH_FRAGMENT_SHADER = R"(
+#version 330 core
+
+in vec2 glib_uv;
+in vec4 glib_color;
+
+uniform sampler2D glib_texture;
+
+void main()
 {
+	gl_FragColor = texture(glib_texture, glib_uv) * glib_color;
 }
+)";
 
-void glib::CameraRenderer::Construct(Window* wnd)
+static const char* INSTANCE_VERTEX_SHADER = R"(
+#version 330 core
+
+layout(location = 0) in vec3 pos;
+layout(location = 1) in vec2 _texCoord;
+layout(location = 2) in vec4 _transform; // x, y, width, height
+layout(location = 3) in vec4 _offset; // offset x, offset y, rotation, flags
+layout(location = 4) in vec4 _uvRect;
+layout(location = 5) in vec4 _color;
+
+out vec2 glib_uv;
+out vec4 glib_color;
+
+uniform mat4 glib_projection_matrix;
+uniform mat4 glib_view_matrix;
+
+void main()
 {
-	m_TextShd = wnd->LoadShader(VERTEX_SHADER, TEXT_FRAGMENT_SHADER);
-	glib::PipelineRenderer::Construct(wnd);
+	vec2 size = _transform.zw;
+	vec2 center = size * 0.5;
+	float r = radians(_offset.z);
+	float c = cos(r);
+	float s = sin(r);
 
-	type = GLIB_PE_CAMERA_RENDERER;
+	// Same as translate(pos) * translate(center) * rotate * translate(-center) * translate(offset) * scale(size)
+	vec2 local = pos.xy * size + _offset.xy - center;
+	vec2 world = vec2(local.x * c - local.y * s, local.x * s + local.y * c) + center + _transform.xy;
 
-	float vertices[] = {
-		// first triangle
-		1.0f,  1.0f, 0.0f, 0.0, 1.0,  // top right
-		1.0f,  0.0f, 0.0f, 0.0, 0.0,  // bottom right
-		0.0f,  1.0f, 0.0f, 1.0, 1.0, // top left
-		// second triangle
-		1.0f,  0.0f, 0.0f, 0.0, 0.0, // bottom right
-		0.0f,  0.0f, 0.0f, 1.0, 0.0, // bottom left
-		0.0f,  1.0f, 0.0f, 1.0, 1.0 // top left
-	};
+	gl_Position = glib_projection_matrix * glib_view_matrix * vec4(world, 0.0, 1.0);
 
-	int verticeCount = 6;
+	int flags = int(_offset.w);
+	vec2 uv = pos.xy;
+	if ((flags & 1) != 0) uv.x = 1.0 - uv.x;
+	if ((flags & 2) != 0) uv.y = 1.0 - uv.y;
 
-	glGenVertexArrays(1, &m_VAOx);
-	glGenBuffers(1, &m_VBOx);
+	glib_uv = uv * _uvRect.zw + _uvRect.xy;
+	glib_color = _color;
+}
+)";
 
-	glBindVertexArray(m_VAOx);
+glib::CameraRenderer::CameraRenderer() : glib::PipelineRenderer(VERTEX_SHADER, FRAGMENT_SHADER), m_BatchShd(nullptr), m_Batch(nullptr), m_InstanceShd(nullptr), m_Instancer(nullptr), m_SpriteMode(SpriteRenderMode::DEFAULT), m_Workers(nullptr), m_Queue(new RenderQueue()), m_UseQueue(false), m_PacketTextVAO(0), m_PacketTextStream(nullptr)
+{
+	m_PooledTarget = true;
+	m_SharedShader = true;
+}
 
-	glBindBuffer(GL_ARRAY_BUFFER, m_VBOx);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * verticeCount * 3 + sizeof(float) * verticeCount * 2, vertices, GL_STATIC_DRAW);
+glib::CameraRenderer::~CameraRenderer()
+{
+	delete m_Batch;
+	delete m_Instancer;
+	delete m_Queue;
+	delete m_Workers;
 
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-	glEnableVertexAttribArray(0);
+	if (m_PacketTextStream != nullptr)
+	{
+		OpenGLProxy::DeleteVertexArrays(1, &m_PacketTextVAO);
+		delete m_PacketTextStream;
+	}
+}
 
-	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-	glEnableVertexAttribArray(1);
+void glib::CameraRenderer::Construct(Window* wnd)
+{
+	m_TextShd = wnd->LoadSharedShader(VERTEX_SHADER, TEXT_FRAGMENT_SHADER);
+	m_BatchShd = wnd->LoadSharedShader(BATCH_VERTEX_SHADER, BATCH_FRAGMENT_SHADER);
+	m_BatchShd->Use();
+	m_BatchShd->SetInt("glib_texture", 0);
+	m_Batch = new SpriteBatch();
+	m_InstanceShd = wnd->LoadSharedShader(INSTANCE_VERTEX_SHADER, BATCH_FRAGMENT_SHADER);
+	m_InstanceShd->Use();
+	m_InstanceShd->SetInt("glib_texture", 0);
+	glib::PipelineRenderer::Construct(wnd);
+	m_Instancer = new SpriteInstancer(m_VBO);
+
+	m_ViewUniform = m_Shd->GetUniform("glib_view_matrix");
+	m_ModelUniform = m_Shd->GetUniform("glib_model_matrix");
+	m_ColorUniform = m_Shd->GetUniform("glib_color");
+	m_UVCoordUniform = m_Shd->GetUniform("glib_uv_coord");
+	m_UVSizeUniform = m_Shd->GetUniform("glib_uv_size");
+	m_TextureUniform = m_Shd->GetUniform("glib_texture");
+	m_TextViewUniform = m_TextShd->GetUniform("glib_view_matrix");
+	m_TextModelUniform = m_TextShd->GetUniform("glib_model_matrix");
+	m_TextColorUniform = m_TextShd->GetUniform("glib_color");
+	m_BatchViewUniform = m_BatchShd->GetUniform("glib_view_matrix");
+	m_InstanceViewUniform = m_InstanceShd->GetUniform("glib_view_matrix");
 
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	type = GLIB_PE_CAMERA_RENDERER;
 }
 
 const PipelineData glib::CameraRenderer::Downstream(const PipelineData data)
 {
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	OpenGLProxy::Enable(GL_BLEND);
+	OpenGLProxy::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	Camera* cam = (Camera*) data.ptr;
+	// Set when a frame packet is drawn (see RenderPipeline::Flush), the camera itself must not be read then
+	const FrameCamera* frame = (const FrameCamera*)data.ptr2;
 
-	m_FB->Bind();
-	glViewport(0, 0, m_Size.x, m_Size.y);
+	// Without effects the sprites go straight into the window (see CanDrawToWindow)
+	Framebuffer* target = BindOutput(m_Wnd, GetRenderSize(m_Size));
 
-	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-	glClear(GL_COLOR_BUFFER_BIT);
+	Mat4 m = frame != nullptr ? frame->view : cam->CalculateView();
 
-	Mat4 m = cam->CalculateView();
+	// The view only changes per camera, so it's uploaded once instead of per drawable
+	m_Shd->Use();
+	m_Shd->SetMat4(m_ViewUniform, m);
+	m_TextShd->Use();
+	m_TextShd->SetMat4(m_TextViewUniform, m);
 
-	for (Drawable* d : cam->GetDrawables())
+	if (frame != nullptr)
 	{
-		if (!d->visible) continue;
+		DrawFramePacket(*frame, *(const FramePacket*)data.ptr3, m);
+		if (target) target->Unbind();
+		return { cam, target ? target->GetInternals().tex : 0 };
+	}
+
+	if (m_SpriteMode == SpriteRenderMode::BATCHED)
+	{
+		m_BatchShd->Use();
+		m_BatchShd->SetMat4(m_BatchViewUniform, m);
+		m_Batch->SetShader(m_BatchShd);
+		m_Batch->ResetStats();
+	}
+	else if (m_SpriteMode == SpriteRenderMode::INSTANCED)
+	{
+		m_InstanceShd->Use();
+		m_InstanceShd->SetMat4(m_InstanceViewUniform, m);
+		m_Instancer->SetShader(m_InstanceShd);
+		m_Instancer->ResetStats();
+	}
 
-		Sprite* s = dynamic_cast<Sprite*>(d);
-		Text* t = dynamic_cast<Text*>(d);
-		VideoPlayer* p = dynamic_cast<VideoPlayer*>(d);
+	// The shader is only switched when the kind of drawable changes
+	Shader* current = nullptr;
 
-		if (s)
+	// Culling reads the bounds of every sprite, which would otherwise update the changed transforms one at a time
+	m_TransformStats = SpriteTransformStats();
+	if (m_SpriteMode != SpriteRenderMode::INSTANCED || cam->IsCulling())
+	{
+		UpdateSpriteTransforms(cam);
+	}
+
+	// Only what overlaps the view (see Camera::SetCulling)
+	const std::vector<Drawable*>& visible = cam->GatherVisible();
+
+	if (m_UseQueue)
+	{
+		m_Queue->Clear();
+		for (Drawable* d : visible)
 		{
-			m_Shd->Use();
-			m_Shd->SetMat4("glib_view_matrix", m);
-			DrawSprite(s, cam->pos, cam->zoom);
+			m_Queue->Push(MakeSortKey(d), d);
 		}
-		else if (t)
+		m_Queue->Sort();
+
+		for (const RenderItem& item : m_Queue->GetItems())
 		{
-			m_TextShd->Use();
-			m_TextShd->SetMat4("glib_view_matrix", m);
-			DrawText(t, cam->pos, cam->zoom);
+			DrawDrawable(item.drawable, cam, current);
 		}
-		else if (p)
+	}
+	else
+	{
+		for (Drawable* d : visible)
 		{
-			m_Shd->Use();
-			m_Shd->SetMat4("glib_view_matrix", m);
-			DrawVideoPlayer(p);
+			DrawDrawable(d, cam, current);
+		}
+	}
+
+	FlushSprites();
+
+	if (!target) return { cam, 0 };
+	target->Unbind();
+
+	return { cam, target->GetInternals().tex };
+}
+
+void glib::CameraRenderer::DrawDrawable(Drawable* d, Camera* cam, Shader*& current)
+{
+	if (d->kind == GLIB_DRAWABLE_SPRITE && m_SpriteMode != SpriteRenderMode::DEFAULT)
+	{
+		if (m_SpriteMode == SpriteRenderMode::BATCHED)
+		{
+			BatchSprite(static_cast<Sprite*>(d), cam->pos);
 		}
 		else
 		{
-			d->Draw();
+			InstanceSprite(static_cast<Sprite*>(d), cam->pos);
 		}
+		// The flush uses its own shader
+		current = nullptr;
+		return;
 	}
 
-	m_FB->Unbind();
+	// Anything that isn't a sprite breaks the batch to keep the draw order
+	FlushSprites();
 
-	return { cam, m_FB->GetInternals().tex };
+	switch (d->kind)
+	{
+	case GLIB_DRAWABLE_SPRITE:
+	{
+		UseShader(m_Shd, current);
+		DrawSprite(static_cast<Sprite*>(d), cam->pos, cam->zoom);
+		break;
+	}
+	case GLIB_DRAWABLE_TEXT:
+	{
+		UseShader(m_TextShd, current);
+		DrawText(static_cast<Text*>(d), cam->pos, cam->zoom);
+		break;
+	}
+	case GLIB_DRAWABLE_VIDEO_PLAYER:
+	{
+		UseShader(m_Shd, current);
+		DrawVideoPlayer(static_cast<VideoPlayer*>(d));
+		break;
+	}
+	default:
+	{
+		d->Draw();
+		// Custom drawables may talk to OpenGL directly
+		OpenGLProxy::InvalidateState();
+		current = nullptr;
+		break;
+	}
+	}
 }
 
-void glib::CameraRenderer::DrawSprite(Sprite* s, const Vec2& cameraPos, float zoom)
+void glib::CameraRenderer::DrawFramePacket(const FrameCamera& frame, const FramePacket& packet, Mat4& view)
 {
-	m_Shd->Use();
+	// Sprites always go through the batch, texts through a stream buffer, so nothing of the drawables themselves is touched
+	m_BatchShd->Use();
+	m_BatchShd->SetMat4(m_BatchViewUniform, view);
+	m_Batch->SetShader(m_BatchShd);
+	m_Batch->ResetStats();
+
+	if (m_PacketTextStream == nullptr)
+	{
+		m_PacketTextStream = new StreamBuffer(PACKET_TEXT_STREAM_SIZE, GL_ARRAY_BUFFER);
+
+		glGenVertexArrays(1, &m_PacketTextVAO);
+		OpenGLProxy::BindVertexArray(m_PacketTextVAO);
+		glBindBuffer(GL_ARRAY_BUFFER, m_PacketTextStream->GetID());
+
+		// Same layout as the text meshes
+		glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+		glEnableVertexAttribArray(0);
+
+		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+		glEnableVertexAttribArray(1);
+
+		OpenGLProxy::BindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	static const float corners[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+
+	for (size_t n = 0; n < frame.itemCount; n++)
+	{
+		const FrameItem& item = packet.items[frame.firstItem + n];
+
+		if (item.kind == GLIB_DRAWABLE_SPRITE)
+		{
+			const Affine2D& t = item.transform;
+
+			BatchVertex vertices[4];
+			for (int i = 0; i < 4; i++)
+			{
+				float x = corners[i][0];
+				float y = corners[i][1];
+
+				vertices[i].x = t.a * x + t.c * y + t.tx;
+				vertices[i].y = t.b * x + t.d * y + t.ty;
+				vertices[i].u = x * item.uvSize.x + item.uvCoord.x;
+				vertices[i].v = y * item.uvSize.y + item.uvCoord.y;
+				vertices[i].color = item.color;
+			}
+
+			m_Batch->Submit(item.texture, vertices);
+			continue;
+		}
 
-	Vec2 pos = s->pos;
-	pos.x -= cameraPos.x * s->scrollFactor.x;
-	pos.y -= cameraPos.y * s->scrollFactor.y;
+		// Keep the draw order
+		m_Batch->Flush();
 
-	Mat4 modelMat;
-	Vec2 diff = Vec2((s->size.x * s->scale.x) - s->size.x, (s->size.y * s->scale.y) - s->size.y);
+		if (item.vertexCount == 0) continue;
 
-	modelMat.Translate(Vec2(pos.x - (diff.x / 2.0f), pos.y - (diff.y / 2.0f)));
+		m_TextShd->Use();
+		Mat4 model = item.transform.ToMat4();
+		m_TextShd->SetMat4(m_TextModelUniform, model);
+		m_TextShd->SetColor(m_TextColorUniform, item.color);
+
+		OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+		OpenGLProxy::BindTexture(GL_TEXTURE_2D, item.texture);
 
-	modelMat.Translate(Vec2(s->size.x / 2.0f * s->scale.x, s->size.y / 2.0f * s->scale.y));
-	modelMat.Rotate(s->rotation);
-	modelMat.Translate(Vec2(-(s->size.x / 2.0f) * s->scale.x, -(s->size.y / 2.0f) * s->scale.y));
-	modelMat.Translate(s->offset);
+		size_t stride = 4 * sizeof(float);
+		size_t offset = m_PacketTextStream->Write(&packet.textVertices[item.firstVertex * 4], item.vertexCount * stride, stride);
 
-	modelMat.Scale(Vec2(s->size.x + diff.x, s->size.y + diff.y));
+		OpenGLProxy::BindVertexArray(m_PacketTextVAO);
+		OpenGLProxy::DrawArrays(GL_TRIANGLES, (int)(offset / stride), (int)item.vertexCount);
+	}
 
-	m_Shd->SetMat4("glib_model_matrix", modelMat);
-	m_Shd->SetColor("glib_color", s->color);
-	m_Shd->SetVec2("glib_uv_coord", s->textureOffset);
-	m_Shd->SetVec2("glib_uv_size", s->textureSize);
+	m_Batch->Flush();
+}
+
+uint64_t glib::CameraRenderer::MakeSortKey(Drawable* d) const
+{
+	// The kind decides the shader, so it's used as the shader part of the key
+	unsigned int texture = 0;
+	if (d->kind == GLIB_DRAWABLE_SPRITE)
+	{
+		Sprite* s = static_cast<Sprite*>(d);
+		if (s->tex != nullptr) texture = s->tex->GetID();
+	}
+
+	// Only alpha blending is supported, so every drawable shares the blend mode
+	return RenderQueue::MakeKey(d->layer, 0, d->kind, texture);
+}
+
+void glib::CameraRenderer::DrawSprite(Sprite* s, const Vec2& cameraPos, float zoom)
+{
+	// Flipping mirrors the quad, so the same vertex array works for every sprite
+	Affine2D transform = s->GetWorldTransform();
+	transform.tx -= cameraPos.x * s->scrollFactor.x;
+	transform.ty -= cameraPos.y * s->scrollFactor.y;
+	Mat4 modelMat = transform.ToMat4();
+
+	Vec2 uvCoord = s->textureOffset;
+	Vec2 uvSize = s->textureSize;
 
 	if (s->tex != nullptr)
 	{
-		m_Shd->SetInt("glib_texture", 0);
-		glActiveTexture(GL_TEXTURE0);
-		s->tex->Bind();
+		// Map into the atlas region (a no-op for normal textures)
+		const Vec2& regionOffset = s->tex->GetUVOffset();
+		const Vec2& regionSize = s->tex->GetUVSize();
+		uvCoord = Vec2(regionOffset.x + uvCoord.x * regionSize.x, regionOffset.y + uvCoord.y * regionSize.y);
+		uvSize = Vec2(uvSize.x * regionSize.x, uvSize.y * regionSize.y);
 	}
 
-	if (s->flipX)
+	m_Shd->SetMat4(m_ModelUniform, modelMat);
+	m_Shd->SetColor(m_ColorUniform, s->color);
+	m_Shd->SetVec2(m_UVCoordUniform, uvCoord);
+	m_Shd->SetVec2(m_UVSizeUniform, uvSize);
+
+	// Nothing is unbound after drawing (the proxy drops repeated binds), so a sprite without texture has to bind 0 itself
+	m_Shd->SetInt(m_TextureUniform, 0);
+	OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+	if (s->tex != nullptr)
 	{
-		glBindVertexArray(m_VAOx);
+		s->tex->Bind();
 	}
 	else
 	{
-		glBindVertexArray(m_VAO);
+		OpenGLProxy::BindTexture(GL_TEXTURE_2D, 0);
 	}
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glBindVertexArray(0);
 
-	if (s->tex != nullptr)
+	OpenGLProxy::BindVertexArray(m_VAO);
+	OpenGLProxy::DrawArrays(GL_TRIANGLES, 0, 6);
+}
+
+void glib::CameraRenderer::BatchSprite(Sprite* s, const Vec2& cameraPos)
+{
+	// Only collected here. The transforms were updated before culling, the ones that changed since are updated in SubmitBatchedSprites
+	m_BatchedSprites.push_back(s);
+	m_BatchCameraPos = cameraPos;
+
+	if (s->IsTransformDirty())
 	{
-		s->tex->Unbind();
+		m_DirtySprites.push_back(s);
+		m_BatchedTransforms.Push(s->pos, s->size, s->scale, s->offset, s->rotation, SpriteFlip(s));
 	}
 }
 
-void glib::CameraRenderer::DrawText(Text* text, const Vec2& cameraPos, float zoom)
+void glib::CameraRenderer::UpdateSpriteTransforms(Camera* cam)
 {
-	m_TextShd->Use();
-	float xOffset = 0.0f;
+	// Culled sprites are included, their bounds are needed to cull them
+	// Static sprites in the spatial hash are culled by their stored bounds, the few that are drawn get updated while drawing
+	for (Drawable* d : cam->GetUnhashedDrawables())
+	{
+		if (d->kind != GLIB_DRAWABLE_SPRITE || !d->visible) continue;
+
+		Sprite* s = static_cast<Sprite*>(d);
+		if (s->IsTransformDirty())
+		{
+			m_DirtySprites.push_back(s);
+			m_BatchedTransforms.Push(s->pos, s->size, s->scale, s->offset, s->rotation, SpriteFlip(s));
+		}
+	}
+
+	m_TransformStats.batched += (unsigned int)m_DirtySprites.size();
+	UpdateDirtyTransforms();
+}
 
-	for (wchar_t c : text->GetText())
+void glib::CameraRenderer::UpdateDirtyTransforms()
+{
+	size_t dirty = m_DirtySprites.size();
+	if (dirty == 0) return;
+
+	m_BatchedAffines.resize(dirty);
+
+	auto update = [this](size_t begin, size_t end)
 	{
-		const Glyph& glyph = text->font->GetGlyph(c);
+		BatchSpriteTransforms(m_BatchedTransforms, begin, end, m_BatchedAffines.data());
+		for (size_t n = begin; n < end; n++)
+		{
+			m_DirtySprites[n]->SetWorldTransform(m_BatchedAffines[n]);
+		}
+	};
 
-		Vec2 pos = text->pos;
-		pos.x -= cameraPos.x * (1 * zoom);
-		pos.y -= cameraPos.y * (1 * zoom);
+	if (m_Workers != nullptr && dirty >= PARALLEL_MIN_SPRITES) m_Workers->ParallelFor(dirty, PARALLEL_CHUNK, update);
+	else update(0, dirty);
 
-		float xpos = pos.x + xOffset + glyph.bearing.x * text->scale;
-		float ypos = pos.y - glyph.bearing.y * text->scale;
+	m_DirtySprites.clear();
+	m_BatchedTransforms.Clear();
+}
 
-		float w = glyph.size.x * text->scale;
-		float h = glyph.size.y * text->scale;
+void glib::CameraRenderer::SubmitBatchedSprites()
+{
+	size_t count = m_BatchedSprites.size();
+	if (count == 0) return;
 
-		Mat4 model;
+	ThreadPool* workers = count >= PARALLEL_MIN_SPRITES ? m_Workers : nullptr;
 
-		model.Translate(Vec2(xpos, ypos));
-		model.Translate(text->offset);
+	// Usually already done by UpdateSpriteTransforms, only sprites that changed since then are left
+	m_TransformStats.late += (unsigned int)m_DirtySprites.size();
+	UpdateDirtyTransforms();
 
-		model.Translate(Vec2(w / 2.0f, h / 2.0f));
-		model.Rotate(text->rotation);
-		model.Translate(Vec2(-(w / 2.0f), -(h / 2.0f)));
+	m_BatchedTextures.resize(count);
 
-		model.Scale(Vec2(w, h));
+	// Every chunk is written straight into the stream buffer, the workers fill disjoint parts of it in sprite order
+	size_t capacity = m_Batch->GetCapacity();
+	for (size_t start = 0; start < count; start += capacity)
+	{
+		size_t quads = count - start < capacity ? count - start : capacity;
+		BatchVertex* vertices = m_Batch->Map(quads);
+		if (vertices == nullptr) break;
 
-		m_TextShd->Use();
-		m_TextShd->SetColor("glib_color", text->color);
-		m_TextShd->SetMat4("glib_model_matrix", model);
+		auto build = [this, start, vertices](size_t begin, size_t end)
+		{
+			BuildBatchVertices(start + begin, start + end, vertices + begin * 4);
+		};
+
+		if (workers != nullptr) workers->ParallelFor(quads, PARALLEL_CHUNK, build);
+		else build(0, quads);
+
+		m_Batch->DrawMapped(&m_BatchedTextures[start], quads);
+	}
+
+	m_BatchedSprites.clear();
+}
+
+void glib::CameraRenderer::BuildBatchVertices(size_t begin, size_t end, BatchVertex* out)
+{
+	static const float corners[4][2] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+
+	for (size_t n = begin; n < end; n++)
+	{
+		Sprite* s = m_BatchedSprites[n];
+		const Affine2D& t = s->GetWorldTransform();
+		float scrollX = m_BatchCameraPos.x * s->scrollFactor.x;
+		float scrollY = m_BatchCameraPos.y * s->scrollFactor.y;
+
+		Vec2 uvCoord = s->textureOffset;
+		Vec2 uvSize = s->textureSize;
+
+		if (s->tex != nullptr)
+		{
+			const Vec2& regionOffset = s->tex->GetUVOffset();
+			const Vec2& regionSize = s->tex->GetUVSize();
+			uvCoord = Vec2(regionOffset.x + uvCoord.x * regionSize.x, regionOffset.y + uvCoord.y * regionSize.y);
+			uvSize = Vec2(uvSize.x * regionSize.x, uvSize.y * regionSize.y);
+		}
+
+		// The flip is part of the transform, so the uvs are the same for every sprite
+		BatchVertex* vertices = out + (n - begin) * 4;
+		for (int i = 0; i < 4; i++)
+		{
+			float x = corners[i][0];
+			float y = corners[i][1];
+
+			vertices[i].x = t.a * x + t.c * y + t.tx - scrollX;
+			vertices[i].y = t.b * x + t.d * y + t.ty - scrollY;
+			vertices[i].u = x * uvSize.x + uvCoord.x;
+			vertices[i].v = y * uvSize.y + uvCoord.y;
+			vertices[i].color = s->color;
+		}
+
+		m_BatchedTextures[n] = s->tex != nullptr ? s->tex->GetID() : 0;
+	}
+}
+
+void glib::CameraRenderer::InstanceSprite(Sprite* s, const Vec2& cameraPos)
+{
+	Vec2 size = Vec2(s->size.x * s->scale.x, s->size.y * s->scale.y);
 
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, glyph.tex);
+	SpriteInstance instance;
+	instance.x = s->pos.x - cameraPos.x * s->scrollFactor.x - (size.x - s->size.x) / 2.0f;
+	instance.y = s->pos.y - cameraPos.y * s->scrollFactor.y - (size.y - s->size.y) / 2.0f;
+	instance.width = size.x;
+	instance.height = size.y;
+	instance.offsetX = s->offset.x;
+	instance.offsetY = s->offset.y;
+	instance.rotation = s->rotation;
+	instance.flags = (float)((s->flipX ? GLIB_SPRITE_FLIP_X : 0) | (s->flipY ? GLIB_SPRITE_FLIP_Y : 0));
 
-		glBindVertexArray(m_VAO);
-		glDrawArrays(GL_TRIANGLES, 0, 6);
-		glBindVertexArray(0);
+	Vec2 uvCoord = s->textureOffset;
+	Vec2 uvSize = s->textureSize;
 
-		xOffset += (glyph.advance >> 6) * text->scale;
+	if (s->tex != nullptr)
+	{
+		const Vec2& regionOffset = s->tex->GetUVOffset();
+		const Vec2& regionSize = s->tex->GetUVSize();
+		uvCoord = Vec2(regionOffset.x + uvCoord.x * regionSize.x, regionOffset.y + uvCoord.y * regionSize.y);
+		uvSize = Vec2(uvSize.x * regionSize.x, uvSize.y * regionSize.y);
 	}
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+	instance.uvX = uvCoord.x;
+	instance.uvY = uvCoord.y;
+	instance.uvWidth = uvSize.x;
+	instance.uvHeight = uvSize.y;
+	instance.color = s->color;
+
+	m_Instancer->Submit(s->tex != nullptr ? s->tex->GetID() : 0, instance);
 }
 
-void glib::CameraRenderer::DrawVideoPlayer(VideoPlayer* player)
+void glib::CameraRenderer::FlushSprites()
 {
-	Mat4 modelMat;
-	Vec2 diff = Vec2((player->size.x * player->scale.x) - player->size.x, (player->size.y * player->scale.y) - player->size.y);
+	if (m_SpriteMode == SpriteRenderMode::BATCHED)
+	{
+		SubmitBatchedSprites();
+		m_Batch->Flush();
+	}
+	else if (m_SpriteMode == SpriteRenderMode::INSTANCED)
+	{
+		m_Instancer->Flush();
+	}
+}
 
-	modelMat.Translate(Vec2(player->pos.x - (diff.x / 2.0f), player->pos.y - (diff.y / 2.0f)));
+void glib::CameraRenderer::DrawText(Text* text, const Vec2& cameraPos, float zoom)
+{
+	if (text->font == nullptr) return;
 
-	modelMat.Rotate(player->rotation);
+	// The glyph quads are cached in text space, so only the position has to be applied here
+	text->UpdateMesh();
 
-	modelMat.Scale(Vec2(player->size.x + diff.x, player->size.y + diff.y));
+	Vec2 pos = text->pos;
+	pos.x -= cameraPos.x * (1 * zoom);
+	pos.y -= cameraPos.y * (1 * zoom);
 
-	m_Shd->Use();
-	m_Shd->SetMat4("glib_model_matrix", modelMat);
-	m_Shd->SetColor("glib_color", { 1.0f, 1.0f, 1.0f, 1.0f });
-	m_Shd->SetVec2("glib_uv_coord", glib::Vec2(0.0f, 0.0f));
-	m_Shd->SetVec2("glib_uv_size", glib::Vec2(1.0f, 1.0f));
+	Mat4 model;
+	model.Translate(pos);
 
-	glActiveTexture(GL_TEXTURE0);
+	m_TextShd->SetColor(m_TextColorUniform, text->color);
+	m_TextShd->SetMat4(m_TextModelUniform, model);
+
+	OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+	OpenGLProxy::BindVertexArray(text->GetMeshVAO());
+
+	// Usually a single range, since all glyphs of a font share one atlas page
+	for (const TextMeshRange& range : text->GetMeshRanges())
+	{
+		OpenGLProxy::BindTexture(GL_TEXTURE_2D, range.tex);
+		OpenGLProxy::DrawArrays(GL_TRIANGLES, range.first, range.count);
+	}
+}
+
+void glib::CameraRenderer::DrawVideoPlayer(VideoPlayer* player)
+{
+	// Video players rotate around their top left corner
+	Mat4 modelMat = MakeSpriteTransform(player->pos, player->size, player->scale, Vec2(0.0f, 0.0f), Vec2(0.0f, 0.0f), player->rotation).ToMat4();
+
+	m_Shd->SetMat4(m_ModelUniform, modelMat);
+	m_Shd->SetColor(m_ColorUniform, { 1.0f, 1.0f, 1.0f, 1.0f });
+	m_Shd->SetVec2(m_UVCoordUniform, glib::Vec2(0.0f, 0.0f));
+	m_Shd->SetVec2(m_UVSizeUniform, glib::Vec2(1.0f, 1.0f));
+
+	OpenGLProxy::ActiveTexture(GL_TEXTURE0);
 	player->Draw();
 
-	glBindVertexArray(m_VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glBindVertexArray(0);
+	OpenGLProxy::BindVertexArray(m_VAO);
+	OpenGLProxy::DrawArrays(GL_TRIANGLES, 0, 6);
+}
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+bool glib::CameraRenderer::CanDrawToWindow() const
+{
+	return GetRenderScale() * pipelineScale == 1.0f;
 }
 
 void glib::CameraRenderer::ConstructFBO(Vec2 pos, Vec2 size)
@@ -291,4 +709,65 @@ void glib::CameraRenderer::ConstructFBO(Vec2 pos, Vec2 size)
 	Mat4 m = Mat4::Ortho(0.0f, m_Wnd->GetInitialSize().x, m_Wnd->GetInitialSize().y, 0.0f);
 	m_TextShd->Use();
 	m_TextShd->SetMat4("glib_projection_matrix", m);
+	m_BatchShd->Use();
+	m_BatchShd->SetMat4("glib_projection_matrix", m);
+	m_InstanceShd->Use();
+	m_InstanceShd->SetMat4("glib_projection_matrix", m);
 }
+
+void glib::CameraRenderer::SetSpriteRenderMode(SpriteRenderMode mode)
+{
+	m_SpriteMode = mode;
+}
+
+SpriteRenderMode glib::CameraRenderer::GetSpriteRenderMode() const
+{
+	return m_SpriteMode;
+}
+
+void glib::CameraRenderer::SetBatching(bool enabled)
+{
+	m_SpriteMode = enabled ? SpriteRenderMode::BATCHED : SpriteRenderMode::DEFAULT;
+}
+
+bool glib::CameraRenderer::IsBatching() const
+{
+	return m_SpriteMode == SpriteRenderMode::BATCHED;
+}
+
+SpriteBatch* glib::CameraRenderer::GetSpriteBatch()
+{
+	return m_Batch;
+}
+
+SpriteInstancer* glib::CameraRenderer::GetSpriteInstancer()
+{
+	return m_Instancer;
+}
+
+
+void glib::CameraRenderer::SetRenderQueue(bool toggle)
+{
+	m_UseQueue = toggle;
+}
+
+bool glib::CameraRenderer::IsRenderQueue() const
+{
+	return m_UseQueue;
+}
+
+void glib::CameraRenderer::SetWorkerThreads(unsigned int threads)
+{
+	delete m_Workers;
+	m_Workers = threads > 0 ? new ThreadPool(threads) : nullptr;
+}
+
+unsigned int glib::CameraRenderer::GetWorkerThreads() const
+{
+	return m_Workers != nullptr ? m_Workers->GetThreadCount() : 0;
+}
+
+const SpriteTransformStats& glib::CameraRenderer::GetTransformStats() const
+{
+	return m_TransformStats;
+}
\ No newline at end of file
@@ -1,4 +1,12 @@
 #include "glib/graphics/pipeline/PipelineElement.h"
+#include "glib/window/Window.h"
+#include "glib/framebuffer/RenderTargetPool.h"
+
+#include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
+
+#include <algorithm>
+#include <cmath>
 
 using namespace glib;
 
@@ -24,3 +32,56 @@ bool glib::PipelineElement::IsExcludedFromCamera(Camera* camera)
 	}
 	return false;
 }
+
+
+void glib::PipelineElement::SetRenderScale(float scale)
+{
+	m_RenderScale = scale;
+}
+
+float glib::PipelineElement::GetRenderScale() const
+{
+	return m_RenderScale;
+}
+
+Vec2 glib::PipelineElement::GetRenderSize(const Vec2& size) const
+{
+	float scale = m_RenderScale * pipelineScale;
+	return Vec2(std::max(1.0f, std::floor(size.x * scale)), std::max(1.0f, std::floor(size.y * scale)));
+}
+
+bool glib::PipelineElement::CanDrawToWindow() const
+{
+	return false;
+}
+
+Framebuffer* glib::PipelineElement::BindOutput(Window* wnd, const Vec2& size)
+{
+	if (toWindow)
+	{
+		// Blended over the earlier cameras like the WindowRenderer would, so it's not cleared
+		OpenGLProxy::BindFramebuffer(GL_FRAMEBUFFER, 0);
+		OpenGLProxy::Viewport(viewportPos.x, viewportPos.y, viewportSize.x, viewportSize.y);
+		OpenGLProxy::Enable(GL_BLEND);
+		return nullptr;
+	}
+
+	Framebuffer* target = wnd->GetRenderTargetPool()->Acquire(size);
+	target->Bind();
+	OpenGLProxy::Viewport(0, 0, size.x, size.y);
+	OpenGLProxy::ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	OpenGLProxy::Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	return target;
+}
+
+void glib::PipelineElement::ResizeTarget(const Vec2& size)
+{
+	m_TargetSize = size;
+}
+
+const PipelineData glib::PipelineElement::FinishOutput(Window* wnd, Framebuffer* target, const PipelineData& data)
+{
+	if (target) target->Unbind();
+	wnd->GetRenderTargetPool()->ReleaseTexture(data.uI);
+	return { data.ptr, target ? target->GetInternals().tex : 0 };
+}
\ No newline at end of file
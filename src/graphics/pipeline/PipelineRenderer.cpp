@@ -3,6 +3,7 @@
 #include "glib/window/Window.h"
 
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 
 static const char* VERTEX_SHADER = R"(
 #version 330 core
@@ -41,11 +42,11 @@ namespace glib
 	};
 }
 
-glib::PipelineRenderer::PipelineRenderer(const std::string& vertexCode, const std::string& fragmentCode) : m_VertexCode(vertexCode), m_FragmentCode(fragmentCode)
+glib::PipelineRenderer::PipelineRenderer(const std::string& vertexCode, const std::string& fragmentCode) : m_FB(nullptr), m_PooledTarget(false), m_SharedShader(false), m_VertexCode(vertexCode), m_FragmentCode(fragmentCode)
 {
 }
 
-glib::PipelineRenderer::PipelineRenderer(const std::string& fragmentCode) : m_VertexCode(VERTEX_SHADER), m_FragmentCode(fragmentCode)
+glib::PipelineRenderer::PipelineRenderer(const std::string& fragmentCode) : m_FB(nullptr), m_PooledTarget(false), m_SharedShader(false), m_VertexCode(VERTEX_SHADER), m_FragmentCode(fragmentCode)
 {
 }
 
@@ -53,8 +54,9 @@ glib::PipelineRenderer::~PipelineRenderer()
 {
 	m_Wnd->GetEventManager().Unsubscribe(m_L);
 	delete m_L;
-	glDeleteVertexArrays(1, &m_VAO);
+	OpenGLProxy::DeleteVertexArrays(1, &m_VAO);
 	glDeleteBuffers(1, &m_VBO);
+	delete m_FB;
 }
 
 void glib::PipelineRenderer::Construct(Window* wnd)
@@ -67,7 +69,7 @@ void glib::PipelineRenderer::Construct(Window* wnd)
 	Vec2 size = wnd->GetInitialSize();
 	m_Size = size;
 
-	m_Shd = wnd->LoadShader(m_VertexCode, m_FragmentCode);
+	m_Shd = m_SharedShader ? wnd->LoadSharedShader(m_VertexCode, m_FragmentCode) : wnd->LoadShader(m_VertexCode, m_FragmentCode);
 	
 	ConstructFBO(Vec2(0.0f, 0.0f), size);
 
@@ -87,7 +89,7 @@ void glib::PipelineRenderer::Construct(Window* wnd)
 	glGenVertexArrays(1, &m_VAO);
 	glGenBuffers(1, &m_VBO);
 
-	glBindVertexArray(m_VAO);
+	OpenGLProxy::BindVertexArray(m_VAO);
 
 	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * verticeCount * 3 + sizeof(float) * verticeCount * 2, vertices, GL_STATIC_DRAW);
@@ -99,16 +101,12 @@ void glib::PipelineRenderer::Construct(Window* wnd)
 	glEnableVertexAttribArray(1);
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	OpenGLProxy::BindVertexArray(0);
 }
 
 void glib::PipelineRenderer::ConstructFBO(Vec2 pos, Vec2 size)
 {
 	m_Wnd->SetToCurrentContext();
-	if (m_FB != nullptr)
-	{
-		delete m_FB;
-	}
 
 	m_Size = size;
 	m_Pos = pos;
@@ -117,5 +115,9 @@ void glib::PipelineRenderer::ConstructFBO(Vec2 pos, Vec2 size)
 	m_Shd->Use();
 	m_Shd->SetMat4("glib_projection_matrix", m);
 
+	// Pooled targets are reallocated lazily by the pool (at most once per frame)
+	if (m_PooledTarget) return;
+
+	delete m_FB;
 	m_FB = new Framebuffer(FramebufferType::TEXTURE, size);
 }
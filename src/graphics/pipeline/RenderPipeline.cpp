@@ -1,10 +1,20 @@
 #include "glib/graphics/pipeline/RenderPipeline.h"
 #include "glib/window/Window.h"
+#include "glib/graphics/pipeline/WindowRenderer.h"
+#include "glib/framebuffer/RenderTargetPool.h"
 #include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <glad/glad.h>
 
 using namespace glib;
 
-glib::RenderPipeline::RenderPipeline(Window* wnd) : m_Wnd(wnd)
+#define RENDER_SCALE_STEP 0.05f
+#define RENDER_SCALE_SETTLE_FRAMES 8 // GPU times arrive two frames late and are smoothed, so a new scale needs a few frames to show
+
+glib::RenderPipeline::RenderPipeline(Window* wnd) : m_Wnd(wnd), m_GPUTiming(true), m_Frame(0), m_RenderScale(1.0f), m_TargetGPUTime(0.0),
+	m_MinRenderScale(0.5f), m_MaxRenderScale(1.0f), m_SmoothedGPUTime(0.0), m_NextScaleFrame(0), m_DirectElement(nullptr)
 {
 }
 
@@ -14,6 +24,16 @@ glib::RenderPipeline::~RenderPipeline()
 	{
 		delete element;
 	}
+
+	for (std::vector<unsigned int>& queries : m_Queries)
+	{
+		if (!queries.empty()) glDeleteQueries((GLsizei)queries.size(), queries.data());
+	}
+
+	for (const auto& layer : m_Layers)
+	{
+		m_Wnd->GetRenderTargetPool()->UnretainTexture(layer.second.texture);
+	}
 }
 
 void glib::RenderPipeline::Update(float delta)
@@ -40,7 +60,7 @@ PipelineElement* glib::RenderPipeline::GetElementByType(uint8_t type) const
 	return nullptr;
 }
 
-void glib::RenderPipeline::Flush(const std::vector<Camera*>& cameras) const
+void glib::RenderPipeline::UpdateViewports() const
 {
 	const Vec2& viewportPos = m_Wnd->GetViewportPos();
 	const Vec2& viewportSize = m_Wnd->GetViewportSize();
@@ -52,18 +72,251 @@ void glib::RenderPipeline::Flush(const std::vector<Camera*>& cameras) const
 
 		element->viewportSize.x = viewportSize.x;
 		element->viewportSize.y = viewportSize.y;
+
+		element->pipelineScale = m_RenderScale;
+		element->frame = m_Frame;
+		element->toWindow = false;
+	}
+
+	// The last element that runs before the WindowRenderer can draw into the window itself, saving the copy
+	m_DirectElement = nullptr;
+	for (size_t i = 0; i < m_Elements.size(); i++)
+	{
+		if (m_Elements[i]->type != GLIB_PE_WINDOW_RENDERER) continue;
+
+		for (size_t j = i; j-- > 0;)
+		{
+			if (m_Elements[j]->fused) continue;
+			if (m_Elements[j]->CanDrawToWindow()) m_DirectElement = m_Elements[j];
+			break;
+		}
+	}
+}
+
+void glib::RenderPipeline::FlushCamera(Camera* camera, PipelineData data, bool retained, uint64_t signature) const
+{
+	RenderTargetPool* pool = m_Wnd->GetRenderTargetPool();
+	const Vec2& viewportSize = m_Wnd->GetViewportSize();
+
+	auto layer = m_Layers.find(camera);
+	if (!retained && layer != m_Layers.end())
+	{
+		pool->UnretainTexture(layer->second.texture);
+		m_Layers.erase(layer);
+		layer = m_Layers.end();
+	}
+
+	bool reuse = layer != m_Layers.end() && layer->second.signature == signature && layer->second.renderScale == m_RenderScale
+		&& layer->second.viewportSize.x == viewportSize.x && layer->second.viewportSize.y == viewportSize.y;
+
+	// A retained camera needs its output in a texture to keep it
+	if (m_DirectElement != nullptr) m_DirectElement->toWindow = !retained;
+
+	bool composite = false;
+	for (PipelineElement* element : m_Elements)
+	{
+		if (element->fused || element->IsExcludedFromCamera(camera)) continue;
+
+		if (!composite && element->type == GLIB_PE_WINDOW_RENDERER)
+		{
+			composite = true;
+			if (reuse)
+			{
+				data.uI = layer->second.texture;
+				layer->second.frame = m_Frame;
+			}
+			else if (retained && data.uI != 0)
+			{
+				if (layer != m_Layers.end()) pool->UnretainTexture(layer->second.texture);
+				pool->RetainTexture(data.uI);
+				m_Layers[camera] = { signature, data.uI, viewportSize, m_RenderScale, m_Frame };
+			}
+		}
+
+		// Nothing changed, so everything up to the composite is still in the layer
+		if (reuse && !composite) continue;
+
+		data = RunElement(element, camera, data);
+	}
+}
+
+void glib::RenderPipeline::BeginStats() const
+{
+	m_Stats.elements.clear();
+	m_Stats.cpuTime = 0.0;
+	m_Stats.gpuTime = 0.0;
+}
+
+const PipelineData glib::RenderPipeline::RunElement(PipelineElement* element, Camera* camera, const PipelineData& data) const
+{
+	PipelineElementStats stats;
+	stats.camera = camera;
+	stats.element = element;
+
+	size_t slot = m_Stats.elements.size();
+	unsigned int query = 0;
+
+	if (m_GPUTiming)
+	{
+		std::vector<unsigned int>& queries = m_Queries[m_Frame & 1];
+		std::vector<PipelineElementStats>& targets = m_QueryTargets[m_Frame & 1];
+
+		if (slot >= queries.size())
+		{
+			glGenQueries(1, &query);
+			queries.push_back(query);
+			targets.push_back(PipelineElementStats());
+		}
+		else
+		{
+			query = queries[slot];
+			PipelineElementStats& target = targets[slot];
+
+			// Issued two frames ago, if the GPU is even further behind the last result is kept instead of waiting
+			GLint available = 0;
+			if (target.element != nullptr) glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+			if (available)
+			{
+				GLuint64 elapsed = 0;
+				glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsed);
+				target.gpuTime = elapsed / 1000000.0;
+			}
+
+			// The slot may have timed something else if cameras or elements changed since
+			if (target.camera == camera && target.element == element) stats.gpuTime = target.gpuTime;
+			else target.gpuTime = 0.0;
+		}
+
+		targets[slot].camera = camera;
+		targets[slot].element = element;
+		glBeginQuery(GL_TIME_ELAPSED, query);
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	PipelineData result = element->Downstream(data);
+	auto end = std::chrono::steady_clock::now();
+
+	if (m_GPUTiming) glEndQuery(GL_TIME_ELAPSED);
+
+	stats.cpuTime = std::chrono::duration<double, std::milli>(end - start).count();
+	m_Stats.cpuTime += stats.cpuTime;
+	m_Stats.gpuTime += stats.gpuTime;
+	m_Stats.elements.push_back(stats);
+
+	return result;
+}
+
+void glib::RenderPipeline::EndStats() const
+{
+	// A camera that wasn't flushed this frame (e.g. removed from the scene) would otherwise hold its layer forever
+	for (auto it = m_Layers.begin(); it != m_Layers.end();)
+	{
+		if (it->second.frame == m_Frame)
+		{
+			++it;
+			continue;
+		}
+
+		m_Wnd->GetRenderTargetPool()->UnretainTexture(it->second.texture);
+		it = m_Layers.erase(it);
 	}
 
+	if (m_TargetGPUTime > 0.0 && m_GPUTiming) UpdateRenderScale();
+	m_Frame++;
+}
+
+void glib::RenderPipeline::UpdateRenderScale() const
+{
+	// No results yet (or the elements changed)
+	if (m_Stats.gpuTime <= 0.0) return;
+
+	m_SmoothedGPUTime = m_SmoothedGPUTime > 0.0 ? m_SmoothedGPUTime * 0.9 + m_Stats.gpuTime * 0.1 : m_Stats.gpuTime;
+	if (m_Frame < m_NextScaleFrame) return;
+
+	// Scaling up needs a larger margin than scaling down, so it doesn't oscillate around the target
+	double ratio = m_TargetGPUTime / m_SmoothedGPUTime;
+	if (ratio > 0.95 && ratio < 1.2) return;
+
+	// Fill cost grows with the area, so the side follows the square root
+	float scale = m_RenderScale * (float)std::sqrt(ratio);
+	scale = std::round(scale / RENDER_SCALE_STEP) * RENDER_SCALE_STEP;
+	scale = std::min(std::max(scale, m_MinRenderScale), m_MaxRenderScale);
+	if (std::abs(scale - m_RenderScale) < RENDER_SCALE_STEP * 0.5f) return;
+
+	m_RenderScale = scale;
+	m_SmoothedGPUTime = 0.0;
+	m_NextScaleFrame = m_Frame + RENDER_SCALE_SETTLE_FRAMES;
+}
+
+void glib::RenderPipeline::Flush(const std::vector<Camera*>& cameras) const
+{
+	UpdateViewports();
+	BeginStats();
+
 	for (Camera* camera : cameras)
 	{
 		PipelineData data{};
 		data.ptr = camera;
 		data.wnd = m_Wnd;
 
-		for (PipelineElement* element : m_Elements)
-		{
-			if (element->IsExcludedFromCamera(camera)) continue;
-			data = element->Downstream(data);
-		}
+		uint64_t signature = 0;
+		bool retained = camera->IsRetained() && camera->CalculateSignature(signature);
+		FlushCamera(camera, data, retained, signature);
 	}
+
+	EndStats();
 }
+
+void glib::RenderPipeline::Flush(const FramePacket& packet) const
+{
+	UpdateViewports();
+	BeginStats();
+
+	for (const FrameCamera& camera : packet.cameras)
+	{
+		PipelineData data{};
+		data.ptr = camera.camera;
+		data.ptr2 = (void*)&camera;
+		data.ptr3 = (void*)&packet;
+		data.wnd = m_Wnd;
+
+		FlushCamera(camera.camera, data, camera.retained, camera.signature);
+	}
+
+	EndStats();
+}
+
+const RenderPipelineStats& glib::RenderPipeline::GetStats() const
+{
+	return m_Stats;
+}
+
+void glib::RenderPipeline::SetGPUTiming(bool toggle)
+{
+	m_GPUTiming = toggle;
+}
+
+bool glib::RenderPipeline::IsGPUTiming() const
+{
+	return m_GPUTiming;
+}
+
+
+void glib::RenderPipeline::SetRenderScale(float scale)
+{
+	m_RenderScale = scale;
+}
+
+float glib::RenderPipeline::GetRenderScale() const
+{
+	return m_RenderScale;
+}
+
+void glib::RenderPipeline::SetDynamicResolution(double targetGPUTime, float minScale, float maxScale)
+{
+	m_TargetGPUTime = targetGPUTime;
+	m_MinRenderScale = minScale;
+	m_MaxRenderScale = maxScale;
+	m_SmoothedGPUTime = 0.0;
+	m_NextScaleFrame = m_Frame;
+}
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "glib/graphics/pipeline/RenderQueue.h"
+
+namespace glib
+{
+	class RenderQueueImpl
+	{
+	private:
+		std::vector<RenderItem> m_Items;
+		std::vector<RenderItem> m_Temp;
+	public:
+		void Clear()
+		{
+			m_Items.clear();
+		}
+
+		void Push(uint64_t key, Drawable* drawable)
+		{
+			m_Items.push_back({ key, drawable });
+		}
+
+		void Sort()
+		{
+			size_t count = m_Items.size();
+			if (count < 2) return;
+
+			m_Temp.resize(count);
+
+			// LSD radix sort, one byte per pass. Stable, so equal keys keep their insertion order
+			for (int shift = 0; shift < 64; shift += 8)
+			{
+				size_t histogram[256] = { 0 };
+				for (const RenderItem& item : m_Items)
+				{
+					histogram[(item.key >> shift) & 0xFF]++;
+				}
+
+				// All keys share this byte, nothing to do
+				if (histogram[(m_Items[0].key >> shift) & 0xFF] == count) continue;
+
+				size_t offset = 0;
+				for (int i = 0; i < 256; i++)
+				{
+					size_t n = histogram[i];
+					histogram[i] = offset;
+					offset += n;
+				}
+
+				for (const RenderItem& item : m_Items)
+				{
+					m_Temp[histogram[(item.key >> shift) & 0xFF]++] = item;
+				}
+
+				m_Items.swap(m_Temp);
+			}
+		}
+
+		const std::vector<RenderItem>& GetItems() const
+		{
+			return m_Items;
+		}
+	};
+}
+
+using namespace glib;
+
+glib::RenderQueue::RenderQueue()
+{
+	impl = new RenderQueueImpl();
+}
+
+glib::RenderQueue::~RenderQueue()
+{
+	delete impl;
+}
+
+uint64_t glib::RenderQueue::MakeKey(int layer, unsigned int blend, unsigned int shader, unsigned int texture)
+{
+	// Bias the layer so negative layers sort before positive ones
+	int biased = layer + 0x8000;
+	if (biased < 0) biased = 0;
+	if (biased > 0xFFFF) biased = 0xFFFF;
+
+	return ((uint64_t)biased << 48) | ((uint64_t)(blend & 0xF) << 44) | ((uint64_t)(shader & 0xFFF) << 32) | (uint64_t)texture;
+}
+
+void glib::RenderQueue::Clear()
+{
+	impl->Clear();
+}
+
+void glib::RenderQueue::Push(uint64_t key, Drawable* drawable)
+{
+	impl->Push(key, drawable);
+}
+
+void glib::RenderQueue::Sort()
+{
+	impl->Sort();
+}
+
+const std::vector<RenderItem>& glib::RenderQueue::GetItems() const
+{
+	return impl->GetItems();
+}
+
+size_t glib::RenderQueue::GetSize() const
+{
+	return impl->GetItems().size();
+}
\ No newline at end of file
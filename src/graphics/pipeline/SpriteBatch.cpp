@@ -0,0 +1,233 @@
+#include "glib/graphics/pipeline/SpriteBatch.h"
+
+#include <vector>
+#include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
+#include "glib/backend/StreamBuffer.h"
+
+namespace glib
+{
+	class SpriteBatchImpl
+	{
+	private:
+		size_t m_MaxQuads;
+		std::vector<BatchVertex> m_Vertices;
+		unsigned int m_VAO;
+		StreamBuffer* m_Stream;
+		unsigned int m_EBO;
+		unsigned int m_Texture;
+		Shader* m_Shader;
+		unsigned int m_DrawCalls;
+		unsigned int m_QuadCount;
+		size_t m_MappedOffset;
+	public:
+		SpriteBatchImpl(size_t maxQuads) : m_MaxQuads(maxQuads), m_VAO(0), m_Stream(nullptr), m_EBO(0), m_Texture(0), m_Shader(nullptr), m_DrawCalls(0), m_QuadCount(0), m_MappedOffset(0)
+		{
+			m_Vertices.reserve(maxQuads * 4);
+
+			std::vector<unsigned int> indices(maxQuads * 6);
+			for (size_t i = 0; i < maxQuads; i++)
+			{
+				unsigned int base = (unsigned int)(i * 4);
+				indices[i * 6 + 0] = base + 0;
+				indices[i * 6 + 1] = base + 1;
+				indices[i * 6 + 2] = base + 2;
+				indices[i * 6 + 3] = base + 2;
+				indices[i * 6 + 4] = base + 3;
+				indices[i * 6 + 5] = base + 0;
+			}
+
+			glGenVertexArrays(1, &m_VAO);
+			glGenBuffers(1, &m_EBO);
+
+			// Room for a few full batches, so the GPU can still draw the previous ones while new ones are written
+			m_Stream = new StreamBuffer(sizeof(BatchVertex) * maxQuads * 4 * GLIB_STREAM_BUFFER_SEGMENTS, GL_ARRAY_BUFFER);
+
+			OpenGLProxy::BindVertexArray(m_VAO);
+
+			glBindBuffer(GL_ARRAY_BUFFER, m_Stream->GetID());
+
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+			glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned int) * indices.size(), indices.data(), GL_STATIC_DRAW);
+
+			glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void*)offsetof(BatchVertex, x));
+			glEnableVertexAttribArray(0);
+
+			glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void*)offsetof(BatchVertex, u));
+			glEnableVertexAttribArray(1);
+
+			glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(BatchVertex), (void*)offsetof(BatchVertex, color));
+			glEnableVertexAttribArray(2);
+
+			OpenGLProxy::BindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		}
+
+		~SpriteBatchImpl()
+		{
+			OpenGLProxy::DeleteVertexArrays(1, &m_VAO);
+			delete m_Stream;
+			glDeleteBuffers(1, &m_EBO);
+		}
+
+		void SetShader(Shader* shader)
+		{
+			if (shader == m_Shader) return;
+			Flush();
+			m_Shader = shader;
+		}
+
+		void Submit(unsigned int texture, const BatchVertex vertices[4])
+		{
+			if (texture != m_Texture || m_Vertices.size() + 4 > m_MaxQuads * 4)
+			{
+				Flush();
+				m_Texture = texture;
+			}
+
+			m_Vertices.insert(m_Vertices.end(), vertices, vertices + 4);
+		}
+
+		void Flush()
+		{
+			if (m_Vertices.empty()) return;
+
+			if (m_Shader != nullptr)
+			{
+				m_Shader->Use();
+			}
+
+			OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+			OpenGLProxy::BindTexture(GL_TEXTURE_2D, m_Texture);
+
+			size_t offset = m_Stream->Write(m_Vertices.data(), sizeof(BatchVertex) * m_Vertices.size(), sizeof(BatchVertex));
+
+			size_t quads = m_Vertices.size() / 4;
+
+			OpenGLProxy::BindVertexArray(m_VAO);
+			OpenGLProxy::DrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)(quads * 6), GL_UNSIGNED_INT, 0, (GLint)(offset / sizeof(BatchVertex)));
+
+			m_DrawCalls++;
+			m_QuadCount += (unsigned int)quads;
+			m_Vertices.clear();
+		}
+
+		BatchVertex* Map(size_t quads)
+		{
+			Flush();
+			if (quads == 0 || quads > m_MaxQuads) return nullptr;
+			return (BatchVertex*)m_Stream->Map(sizeof(BatchVertex) * quads * 4, sizeof(BatchVertex), m_MappedOffset);
+		}
+
+		void DrawMapped(const unsigned int* textures, size_t quads)
+		{
+			m_Stream->Unmap();
+			if (quads == 0) return;
+
+			if (m_Shader != nullptr)
+			{
+				m_Shader->Use();
+			}
+
+			OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+			OpenGLProxy::BindVertexArray(m_VAO);
+
+			GLint baseVertex = (GLint)(m_MappedOffset / sizeof(BatchVertex));
+
+			size_t first = 0;
+			while (first < quads)
+			{
+				size_t last = first + 1;
+				while (last < quads && textures[last] == textures[first]) last++;
+
+				OpenGLProxy::BindTexture(GL_TEXTURE_2D, textures[first]);
+				OpenGLProxy::DrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)((last - first) * 6), GL_UNSIGNED_INT, 0, baseVertex + (GLint)(first * 4));
+
+				m_DrawCalls++;
+				m_QuadCount += (unsigned int)(last - first);
+				first = last;
+			}
+
+			m_Texture = textures[quads - 1];
+		}
+
+		size_t GetCapacity() const
+		{
+			return m_MaxQuads;
+		}
+
+		void ResetStats()
+		{
+			m_DrawCalls = 0;
+			m_QuadCount = 0;
+		}
+
+		unsigned int GetDrawCalls() const
+		{
+			return m_DrawCalls;
+		}
+
+		unsigned int GetQuadCount() const
+		{
+			return m_QuadCount;
+		}
+	};
+}
+
+using namespace glib;
+
+glib::SpriteBatch::SpriteBatch(size_t maxQuads)
+{
+	impl = new SpriteBatchImpl(maxQuads);
+}
+
+glib::SpriteBatch::~SpriteBatch()
+{
+	delete impl;
+}
+
+void glib::SpriteBatch::SetShader(Shader* shader)
+{
+	impl->SetShader(shader);
+}
+
+void glib::SpriteBatch::Submit(unsigned int texture, const BatchVertex vertices[4])
+{
+	impl->Submit(texture, vertices);
+}
+
+void glib::SpriteBatch::Flush()
+{
+	impl->Flush();
+}
+
+BatchVertex* glib::SpriteBatch::Map(size_t quads)
+{
+	return impl->Map(quads);
+}
+
+void glib::SpriteBatch::DrawMapped(const unsigned int* textures, size_t quads)
+{
+	impl->DrawMapped(textures, quads);
+}
+
+size_t glib::SpriteBatch::GetCapacity() const
+{
+	return impl->GetCapacity();
+}
+
+void glib::SpriteBatch::ResetStats()
+{
+	impl->ResetStats();
+}
+
+unsigned int glib::SpriteBatch::GetDrawCalls() const
+{
+	return impl->GetDrawCalls();
+}
+
+unsigned int glib::SpriteBatch::GetQuadCount() const
+{
+	return impl->GetQuadCount();
+}
\ No newline at end of file
@@ -0,0 +1,159 @@
+#include "glib/graphics/pipeline/SpriteInstancer.h"
+
+#include <vector>
+#include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
+#include "glib/backend/StreamBuffer.h"
+
+namespace glib
+{
+	class SpriteInstancerImpl
+	{
+	private:
+		size_t m_MaxInstances;
+		std::vector<SpriteInstance> m_Instances;
+		unsigned int m_VAO;
+		StreamBuffer* m_Stream;
+		unsigned int m_Texture;
+		Shader* m_Shader;
+		unsigned int m_DrawCalls;
+		unsigned int m_InstanceCount;
+	public:
+		SpriteInstancerImpl(unsigned int quadVBO, size_t maxInstances) : m_MaxInstances(maxInstances), m_VAO(0), m_Stream(nullptr), m_Texture(0), m_Shader(nullptr), m_DrawCalls(0), m_InstanceCount(0)
+		{
+			m_Instances.reserve(maxInstances);
+
+			glGenVertexArrays(1, &m_VAO);
+			// Room for a few full batches, so the GPU can still draw the previous ones while new ones are written
+			m_Stream = new StreamBuffer(sizeof(SpriteInstance) * maxInstances * GLIB_STREAM_BUFFER_SEGMENTS, GL_ARRAY_BUFFER);
+
+			OpenGLProxy::BindVertexArray(m_VAO);
+
+			// Per vertex: the shared unit quad
+			glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+
+			glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+			glEnableVertexAttribArray(0);
+
+			glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+			glEnableVertexAttribArray(1);
+
+			// Per instance
+			glBindBuffer(GL_ARRAY_BUFFER, m_Stream->GetID());
+
+			for (unsigned int i = 0; i < 4; i++)
+			{
+				glVertexAttribPointer(2 + i, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteInstance), (void*)(i * 4 * sizeof(float)));
+				glEnableVertexAttribArray(2 + i);
+				glVertexAttribDivisor(2 + i, 1);
+			}
+
+			OpenGLProxy::BindVertexArray(0);
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		}
+
+		~SpriteInstancerImpl()
+		{
+			OpenGLProxy::DeleteVertexArrays(1, &m_VAO);
+			delete m_Stream;
+		}
+
+		void SetShader(Shader* shader)
+		{
+			if (shader == m_Shader) return;
+			Flush();
+			m_Shader = shader;
+		}
+
+		void Submit(unsigned int texture, const SpriteInstance& instance)
+		{
+			if (texture != m_Texture || m_Instances.size() >= m_MaxInstances)
+			{
+				Flush();
+				m_Texture = texture;
+			}
+
+			m_Instances.push_back(instance);
+		}
+
+		void Flush()
+		{
+			if (m_Instances.empty()) return;
+
+			if (m_Shader != nullptr)
+			{
+				m_Shader->Use();
+			}
+
+			OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+			OpenGLProxy::BindTexture(GL_TEXTURE_2D, m_Texture);
+
+			size_t offset = m_Stream->Write(m_Instances.data(), sizeof(SpriteInstance) * m_Instances.size(), sizeof(SpriteInstance));
+
+			OpenGLProxy::BindVertexArray(m_VAO);
+			OpenGLProxy::DrawArraysInstancedBaseInstance(GL_TRIANGLES, 0, 6, (GLsizei)m_Instances.size(), (GLuint)(offset / sizeof(SpriteInstance)));
+
+			m_DrawCalls++;
+			m_InstanceCount += (unsigned int)m_Instances.size();
+			m_Instances.clear();
+		}
+
+		void ResetStats()
+		{
+			m_DrawCalls = 0;
+			m_InstanceCount = 0;
+		}
+
+		unsigned int GetDrawCalls() const
+		{
+			return m_DrawCalls;
+		}
+
+		unsigned int GetInstanceCount() const
+		{
+			return m_InstanceCount;
+		}
+	};
+}
+
+using namespace glib;
+
+glib::SpriteInstancer::SpriteInstancer(unsigned int quadVBO, size_t maxInstances)
+{
+	impl = new SpriteInstancerImpl(quadVBO, maxInstances);
+}
+
+glib::SpriteInstancer::~SpriteInstancer()
+{
+	delete impl;
+}
+
+void glib::SpriteInstancer::SetShader(Shader* shader)
+{
+	impl->SetShader(shader);
+}
+
+void glib::SpriteInstancer::Submit(unsigned int texture, const SpriteInstance& instance)
+{
+	impl->Submit(texture, instance);
+}
+
+void glib::SpriteInstancer::Flush()
+{
+	impl->Flush();
+}
+
+void glib::SpriteInstancer::ResetStats()
+{
+	impl->ResetStats();
+}
+
+unsigned int glib::SpriteInstancer::GetDrawCalls() const
+{
+	return impl->GetDrawCalls();
+}
+
+unsigned int glib::SpriteInstancer::GetInstanceCount() const
+{
+	return impl->GetInstanceCount();
+}
\ No newline at end of file
@@ -1,7 +1,9 @@
 #include "glib/graphics/pipeline/WindowRenderer.h"
 #include "glib/window/Window.h"
+#include "glib/framebuffer/RenderTargetPool.h"
 
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 
 using namespace glib;
 static const char* VERTEX_SHADER = R"(
@@ -32,13 +34,13 @@ void main()
 }
 )";
 
-glib::WindowRenderer::WindowRenderer() : m_Shd(nullptr), m_VAO(0), m_VBO(0)
+glib::WindowRenderer::WindowRenderer() : m_Wnd(nullptr), m_Shd(nullptr), m_VAO(0), m_VBO(0), m_Blit(true), m_LastFrame(~0u)
 {
 }
 
 glib::WindowRenderer::~WindowRenderer()
 {
-	glDeleteVertexArrays(1, &m_VAO);
+	OpenGLProxy::DeleteVertexArrays(1, &m_VAO);
 	glDeleteBuffers(1, &m_VBO);
 }
 
@@ -46,9 +48,10 @@ glib::WindowRenderer::~WindowRenderer()
 void glib::WindowRenderer::Construct(Window* wnd)
 {
 	type = GLIB_PE_WINDOW_RENDERER;
-	glDisable(GL_BLEND);
+	m_Wnd = wnd;
+	OpenGLProxy::Disable(GL_BLEND);
 
-	m_Shd = wnd->LoadShader(VERTEX_SHADER, FRAGMENT_SHADER);
+	m_Shd = wnd->LoadSharedShader(VERTEX_SHADER, FRAGMENT_SHADER);
 	m_Shd->Use();
 
 	float vertices[] = {
@@ -67,7 +70,7 @@ void glib::WindowRenderer::Construct(Window* wnd)
 	glGenVertexArrays(1, &m_VAO);
 	glGenBuffers(1, &m_VBO);
 
-	glBindVertexArray(m_VAO);
+	OpenGLProxy::BindVertexArray(m_VAO);
 
 	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * verticeCount * 3 + sizeof(float) * verticeCount * 2, vertices, GL_STATIC_DRAW);
@@ -79,24 +82,52 @@ void glib::WindowRenderer::Construct(Window* wnd)
 	glEnableVertexAttribArray(1);
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	OpenGLProxy::BindVertexArray(0);
+}
+
+void glib::WindowRenderer::SetBlit(bool toggle)
+{
+	m_Blit = toggle;
 }
 
 const PipelineData glib::WindowRenderer::Downstream(const PipelineData data)
 {
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	bool first = frame != m_LastFrame;
+	m_LastFrame = frame;
+
+	// Already drawn into the window by the previous element (see PipelineElement::CanDrawToWindow)
+	if (data.uI == 0) return {};
+
+	// Nothing is under the first camera but the cleared window, so there's nothing to blend with
+	Vec2 size;
+	Framebuffer* source = m_Wnd->GetRenderTargetPool()->FindTarget(data.uI, size);
+	if (m_Blit && first && source)
+	{
+		OpenGLProxy::BindFramebuffer(GL_READ_FRAMEBUFFER, source->GetInternals().fbo);
+		OpenGLProxy::BindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+		glBlitFramebuffer(0, 0, (int)size.x, (int)size.y, (int)viewportPos.x, (int)viewportPos.y,
+			(int)(viewportPos.x + viewportSize.x), (int)(viewportPos.y + viewportSize.y), GL_COLOR_BUFFER_BIT, GL_LINEAR);
+		OpenGLProxy::BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+		m_Wnd->GetRenderTargetPool()->ReleaseTexture(data.uI);
+		return {};
+	}
+
+	OpenGLProxy::Enable(GL_BLEND);
+	OpenGLProxy::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	m_Shd->Use();
 
-	glViewport(viewportPos.x, viewportPos.y, viewportSize.x, viewportSize.y);
+	OpenGLProxy::Viewport(viewportPos.x, viewportPos.y, viewportSize.x, viewportSize.y);
 
-	glBindTexture(GL_TEXTURE_2D, data.uI);
+	// The input may be smaller than the viewport (see PipelineElement::SetRenderScale), it's stretched with linear filtering
+	OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+	OpenGLProxy::BindTexture(GL_TEXTURE_2D, data.uI);
 
-	glBindVertexArray(m_VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glBindVertexArray(0);
+	OpenGLProxy::BindVertexArray(m_VAO);
+	OpenGLProxy::DrawArrays(GL_TRIANGLES, 0, 6);
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+	// Free for the next camera
+	m_Wnd->GetRenderTargetPool()->ReleaseTexture(data.uI);
 	return {};
 }
\ No newline at end of file
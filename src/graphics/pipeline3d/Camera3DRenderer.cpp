@@ -8,6 +8,7 @@
 
 #include <memory>
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 
 using namespace glib;
 
@@ -54,8 +55,17 @@ void main()
 }
 )";
 
+// Indexed by GLIB_MESH_TEX_TYPE_* - 1
+static const char* TEXTURE_UNIFORM_NAMES[4] = {
+	"glib_texture_diffuse",
+	"glib_texture_specular",
+	"glib_texture_normal",
+	"glib_texture_height"
+};
+
 glib::Camera3DRenderer::Camera3DRenderer() : glib::PipelineRenderer(VERTEX_SHADER, FRAGMENT_SHADER)
 {
+	m_SharedShader = true;
 }
 
 glib::Camera3DRenderer::~Camera3DRenderer()
@@ -66,39 +76,54 @@ void glib::Camera3DRenderer::Construct(Window* wnd)
 {
 	glib::PipelineRenderer::Construct(wnd);
 	type = GLIB_PE_CAMERA_RENDERER_3D;
+
+	m_ViewUniform = m_Shd->GetUniform("glib_view_matrix");
+	m_ModelUniform = m_Shd->GetUniform("glib_model_matrix");
+	m_ColorUniform = m_Shd->GetUniform("glib_color");
+	m_UVPosUniform = m_Shd->GetUniform("glib_uv_pos");
+	m_UVSizeUniform = m_Shd->GetUniform("glib_uv_size");
+	m_UseColorUniform = m_Shd->GetUniform("useColor");
+
+	for (int type = 0; type < 4; type++)
+	{
+		for (int i = 0; i < GLIB_MESH_TEXTURE_UNIFORMS; i++)
+		{
+			m_TextureUniforms[type][i] = m_Shd->GetUniform(TEXTURE_UNIFORM_NAMES[type] + std::to_string(i + 1));
+		}
+	}
 }
 
 static float rot = 0.0f;
 
 const PipelineData glib::Camera3DRenderer::Downstream(const PipelineData data)
 {
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glEnable(GL_MULTISAMPLE);
-	glEnable(GL_DEPTH_TEST);
+	OpenGLProxy::BindFramebuffer(GL_FRAMEBUFFER, 0);
+	OpenGLProxy::Enable(GL_BLEND);
+	OpenGLProxy::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	OpenGLProxy::Enable(GL_MULTISAMPLE);
+	OpenGLProxy::Enable(GL_DEPTH_TEST);
 	glDepthFunc(GL_LESS);
 
 	Camera3D* cam = (Camera3D*)data.ptr;
 
-	glViewport(viewportPos.x, viewportPos.y, viewportSize.x, viewportSize.y);
-	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	OpenGLProxy::Viewport(viewportPos.x, viewportPos.y, viewportSize.x, viewportSize.y);
+	OpenGLProxy::ClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+	OpenGLProxy::Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 	m_Shd->Use();
 
 	Mat4 m = cam->CalculateView();
 
-	m_Shd->SetMat4("glib_view_matrix", m);
+	m_Shd->SetMat4(m_ViewUniform, m);
 
 	for (Drawable* d : cam->GetDrawables())
 	{
 		if (!d->visible) continue;
-		Object3D* obj = dynamic_cast<Object3D*>(d);
-		if (!obj) continue;
+		if (d->kind != GLIB_DRAWABLE_OBJECT_3D) continue;
+		Object3D* obj = static_cast<Object3D*>(d);
 		if (obj->model == nullptr) continue;
 
-		m_Shd->SetColor("glib_color", obj->color);
+		m_Shd->SetColor(m_ColorUniform, obj->color);
 
 		Mat4 modelMat;
 		modelMat.Translate(obj->pos);
@@ -110,9 +135,9 @@ const PipelineData glib::Camera3DRenderer::Downstream(const PipelineData data)
 		modelMat.Rotate(obj->rotation.z, glib::Vec3(0.0f, 0.0f, 1.0f));
 		modelMat.Translate(-obj->pivotPoint);
 
-		m_Shd->SetMat4("glib_model_matrix", modelMat);
-		m_Shd->SetVec2("glib_uv_pos", obj->uvPos);
-		m_Shd->SetVec2("glib_uv_size", obj->uvSize);
+		m_Shd->SetMat4(m_ModelUniform, modelMat);
+		m_Shd->SetVec2(m_UVPosUniform, obj->uvPos);
+		m_Shd->SetVec2(m_UVSizeUniform, obj->uvSize);
 
 		for (Mesh* mesh : obj->model->m_Meshes)
 		{
@@ -121,52 +146,58 @@ const PipelineData glib::Camera3DRenderer::Downstream(const PipelineData data)
 			unsigned int normalNr = 1;
 			unsigned int heightNr = 1;
 			
-			m_Shd->SetInt("useColor", mesh->m_Textures.size() < 1);
+			m_Shd->SetInt(m_UseColorUniform, mesh->m_Textures.size() < 1);
 			
 			for (unsigned int i = 0; i < mesh->m_Textures.size(); i++)
 			{
-				glActiveTexture(GL_TEXTURE0 + i);
+				OpenGLProxy::ActiveTexture(GL_TEXTURE0 + i);
 				MeshTexture& tex = mesh->m_Textures[i];
 
-				std::string num;
+				unsigned int num = 0;
 
 				switch (tex.type)
 				{
 				case GLIB_MESH_TEX_TYPE_DIFFUSE:
 				{
-					num = "glib_texture_diffuse" + std::to_string(diffuseNr);
+					num = diffuseNr;
 					diffuseNr++;
 					break;
 				}
 				case GLIB_MESH_TEX_TYPE_SPECULAR:
 				{
-					num = "glib_texture_specular" + std::to_string(specularNr);
+					num = specularNr;
 					specularNr++;
 					break;
+				}
 				case GLIB_MESH_TEX_TYPE_NORMAL:
 				{
-					num = "glib_texture_normal" + std::to_string(normalNr);
+					num = normalNr;
 					normalNr++;
 					break;
 				}
 				case GLIB_MESH_TEX_TYPE_HEIGHT:
 				{
-					num = "glib_texture_height" + std::to_string(heightNr);
+					num = heightNr;
 					heightNr++;
 					break;
 				}
 				}
-				}
 
-				m_Shd->SetInt(num, i);
-				glBindTexture(GL_TEXTURE_2D, tex.id);
+				if (num > 0 && num <= GLIB_MESH_TEXTURE_UNIFORMS)
+				{
+					m_Shd->SetInt(m_TextureUniforms[tex.type - 1][num - 1], i);
+				}
+				else if (num > 0)
+				{
+					m_Shd->SetInt(TEXTURE_UNIFORM_NAMES[tex.type - 1] + std::to_string(num), i);
+				}
+				OpenGLProxy::BindTexture(GL_TEXTURE_2D, tex.id);
 			}
 
-			glBindVertexArray(mesh->m_VAO);
-			glDrawElements(GL_TRIANGLES, mesh->m_Indices.size(), GL_UNSIGNED_INT, 0);
-			glBindVertexArray(0);
+			OpenGLProxy::BindVertexArray(mesh->m_VAO);
+			OpenGLProxy::DrawElements(GL_TRIANGLES, mesh->m_Indices.size(), GL_UNSIGNED_INT, 0);
 
-			glActiveTexture(GL_TEXTURE0);
+			OpenGLProxy::ActiveTexture(GL_TEXTURE0);
 		}
 	}
 
@@ -23,6 +23,14 @@ void glib::RenderPipeline3D::Update(float delta)
 	m_Cam3D->Update(delta);
 }
 
+void glib::RenderPipeline3D::AddElement(PipelineElement* element)
+{
+	RenderPipeline::AddElement(element);
+
+	// The 3D scene is already in the window, so the cameras have to be blended over it
+	if (element->type == GLIB_PE_WINDOW_RENDERER) ((WindowRenderer*)element)->SetBlit(false);
+}
+
 Camera3D* glib::RenderPipeline3D::GetCamera()
 {
 	return m_Cam3D;
@@ -30,21 +38,15 @@ Camera3D* glib::RenderPipeline3D::GetCamera()
 
 void glib::RenderPipeline3D::Flush(const std::vector<Camera*>& cameras) const
 {
-	const Vec2& viewportPos = m_Wnd->GetViewportPos();
-	const Vec2& viewportSize = m_Wnd->GetViewportSize();
+	UpdateViewports();
 
-	for (PipelineElement* element : m_Elements)
-	{
-		element->viewportPos.x = viewportPos.x;
-		element->viewportPos.y = viewportPos.y;
-		element->viewportSize.x = viewportSize.x;
-		element->viewportSize.y = viewportSize.y;
-	}
+	// The 3D renderer draws straight into the window, so it always runs at full resolution
+	m_Renderer3D->viewportPos = m_Wnd->GetViewportPos();
+	m_Renderer3D->viewportSize = m_Wnd->GetViewportSize();
 
-	m_Renderer3D->viewportPos = viewportPos;
-	m_Renderer3D->viewportSize = viewportSize;
+	BeginStats();
 
-	m_Renderer3D->Downstream({ m_Cam3D, 0, 0, 0, m_Wnd });
+	RunElement(m_Renderer3D, nullptr, { m_Cam3D, 0, 0, 0, m_Wnd });
 
 	for (Camera* camera : cameras)
 	{
@@ -52,10 +54,10 @@ void glib::RenderPipeline3D::Flush(const std::vector<Camera*>& cameras) const
 		data.ptr = camera;
 		data.wnd = m_Wnd;
 
-		for (PipelineElement* element : m_Elements)
-		{
-			if (element->IsExcludedFromCamera(camera)) continue;
-			data = element->Downstream(data);
-		}
+		uint64_t signature = 0;
+		bool retained = camera->IsRetained() && camera->CalculateSignature(signature);
+		FlushCamera(camera, data, retained, signature);
 	}
+
+	EndStats();
 }
@@ -0,0 +1,299 @@
+#include "glib/graphics/postprocessing/BloomEffect.h"
+#include "glib/event/EventManager.h"
+#include "glib/window/Window.h"
+#include "glib/framebuffer/RenderTargetPool.h"
+#include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
+#include <algorithm>
+#include <cmath>
+
+#define BLOOM_MAX_ITERATIONS 8
+
+static const char* VERTEX_SHADER = R"(
+#version 330 core
+
+layout(location = 0) in vec3 pos;
+layout(location = 1) in vec2 _texCoord;
+
+out vec2 glib_uv;
+
+void main()
+{
+	gl_Position = vec4(pos, 1.0);
+	glib_uv = _texCoord;
+}
+)";
+
+// Keeps what's above the threshold, with a soft knee so pixels don't pop in
+static const char* BRIGHT_SHADER = R"(
+#version 330 core
+
+uniform sampler2D glib_input;
+uniform float glib_threshold;
+
+in vec2 glib_uv;
+out vec4 glib_frag_color;
+
+void main()
+{
+	vec3 color = texture(glib_input, glib_uv).rgb;
+	float brightness = max(color.r, max(color.g, color.b));
+	float knee = glib_threshold * 0.5;
+	float soft = clamp(brightness - glib_threshold + knee, 0.0, 2.0 * knee);
+	soft = soft * soft / (4.0 * knee + 0.00001);
+	float contribution = max(soft, brightness - glib_threshold) / max(brightness, 0.00001);
+	glib_frag_color = vec4(color * contribution, 1.0);
+}
+)";
+
+// Dual filter downsample: the center and the four diagonals half a texel away, each a bilinear tap of four texels
+static const char* DOWN_SHADER = R"(
+#version 330 core
+
+uniform sampler2D glib_input;
+uniform vec2 glib_half_pixel;
+
+in vec2 glib_uv;
+out vec4 glib_frag_color;
+
+void main()
+{
+	vec4 sum = texture(glib_input, glib_uv) * 4.0;
+	sum += texture(glib_input, glib_uv - glib_half_pixel);
+	sum += texture(glib_input, glib_uv + glib_half_pixel);
+	sum += texture(glib_input, glib_uv + vec2(glib_half_pixel.x, -glib_half_pixel.y));
+	sum += texture(glib_input, glib_uv - vec2(glib_half_pixel.x, -glib_half_pixel.y));
+	glib_frag_color = sum / 8.0;
+}
+)";
+
+// Dual filter upsample: a tent of eight taps around the pixel
+static const char* UP_SHADER = R"(
+#version 330 core
+
+uniform sampler2D glib_input;
+uniform vec2 glib_half_pixel;
+
+in vec2 glib_uv;
+out vec4 glib_frag_color;
+
+void main()
+{
+	vec2 h = glib_half_pixel;
+	vec4 sum = texture(glib_input, glib_uv + vec2(-h.x * 2.0, 0.0));
+	sum += texture(glib_input, glib_uv + vec2(-h.x, h.y)) * 2.0;
+	sum += texture(glib_input, glib_uv + vec2(0.0, h.y * 2.0));
+	sum += texture(glib_input, glib_uv + vec2(h.x, h.y)) * 2.0;
+	sum += texture(glib_input, glib_uv + vec2(h.x * 2.0, 0.0));
+	sum += texture(glib_input, glib_uv + vec2(h.x, -h.y)) * 2.0;
+	sum += texture(glib_input, glib_uv + vec2(0.0, -h.y * 2.0));
+	sum += texture(glib_input, glib_uv + vec2(-h.x, -h.y)) * 2.0;
+	glib_frag_color = sum / 12.0;
+}
+)";
+
+static const char* COMPOSITE_SHADER = R"(
+#version 330 core
+
+uniform sampler2D glib_input;
+uniform sampler2D glib_bloom;
+uniform float glib_strength;
+
+in vec2 glib_uv;
+out vec4 glib_frag_color;
+
+void main()
+{
+	vec4 color = texture(glib_input, glib_uv);
+	vec3 bloom = texture(glib_bloom, glib_uv).rgb * glib_strength;
+
+	// The glow may spread into transparent areas, so it brings its own coverage
+	float alpha = min(1.0, color.a + max(bloom.r, max(bloom.g, bloom.b)));
+	glib_frag_color = vec4(color.rgb + bloom, alpha);
+}
+)";
+
+using namespace glib;
+
+namespace glib
+{
+	class BloomEffect_Listener : public EventSubscriber
+	{
+	private:
+		BloomEffect* m_Parent;
+	public:
+		BloomEffect_Listener(BloomEffect* parent) : m_Parent(parent)
+		{
+		}
+
+		void OnWindowResize(const WindowResizeEvent& event) override
+		{
+			m_Parent->ConstructFBO(Vec2(event.x, event.y), Vec2(event.width, event.height));
+		}
+	};
+}
+
+glib::BloomEffect::BloomEffect(const BloomParams& params)
+{
+	m_Strength = params.strength;
+	m_Threshold = params.threshold;
+	m_Iterations = params.iterations;
+}
+
+glib::BloomEffect::~BloomEffect()
+{
+	m_Wnd->GetEventManager().Unsubscribe((EventSubscriber*)m_L);
+	delete (BloomEffect_Listener*)m_L;
+	OpenGLProxy::DeleteVertexArrays(1, &m_VAO);
+	glDeleteBuffers(1, &m_VBO);
+}
+
+void glib::BloomEffect::SetStrength(float strength)
+{
+	m_Strength = strength;
+}
+
+void glib::BloomEffect::SetThreshold(float threshold)
+{
+	m_Threshold = threshold;
+}
+
+void glib::BloomEffect::SetIterations(int iterations)
+{
+	m_Iterations = iterations;
+}
+
+void glib::BloomEffect::Construct(Window* wnd)
+{
+	type = GLIB_PE_EFFECT_BLOOM;
+
+	m_Wnd = wnd;
+	wnd->SetToCurrentContext();
+
+	m_L = new BloomEffect_Listener(this);
+	wnd->GetEventManager().Subscribe(GLIB_EVENT_WINDOW_RESIZE, (EventSubscriber*)m_L);
+
+	m_BrightShd = wnd->LoadSharedShader(VERTEX_SHADER, BRIGHT_SHADER);
+	m_DownShd = wnd->LoadSharedShader(VERTEX_SHADER, DOWN_SHADER);
+	m_UpShd = wnd->LoadSharedShader(VERTEX_SHADER, UP_SHADER);
+	m_CompositeShd = wnd->LoadSharedShader(VERTEX_SHADER, COMPOSITE_SHADER);
+	m_CompositeShd->Use();
+	m_CompositeShd->SetInt("glib_bloom", 1);
+
+	ConstructFBO(glib::Vec2(0.0f, 0.0f), wnd->GetInitialSize());
+
+	float vertices[] = {
+		// first triangle
+		1.0f,  1.0f, 0.0f, 1.0, 1.0,  // top right
+		1.0f,  -1.0f, 0.0f, 1.0, 0.0,  // bottom right
+		-1.0f,  1.0f, 0.0f, 0.0, 1.0, // top left
+		// second triangle
+		1.0f,  -1.0f, 0.0f, 1.0, 0.0, // bottom right
+		-1.0f,  -1.0f, 0.0f, 0.0, 0.0, // bottom left
+		-1.0f,  1.0f, 0.0f,  0.0, 1.0 // top left
+	};
+
+	int verticeCount = 6;
+
+	glGenVertexArrays(1, &m_VAO);
+	glGenBuffers(1, &m_VBO);
+
+	OpenGLProxy::BindVertexArray(m_VAO);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * verticeCount * 3 + sizeof(float) * verticeCount * 2, vertices, GL_STATIC_DRAW);
+
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	OpenGLProxy::BindVertexArray(0);
+}
+
+unsigned int glib::BloomEffect::Pass(Shader* shader, unsigned int input, const Vec2& inputSize, const Vec2& size)
+{
+	// Every pixel is written, so the target doesn't need to be cleared
+	Framebuffer* target = m_Wnd->GetRenderTargetPool()->Acquire(size);
+	target->Bind();
+	OpenGLProxy::Viewport(0, 0, size.x, size.y);
+
+	shader->Use();
+	shader->SetVec2("glib_half_pixel", Vec2(0.5f / inputSize.x, 0.5f / inputSize.y));
+
+	OpenGLProxy::BindTexture(GL_TEXTURE_2D, input);
+	OpenGLProxy::DrawArrays(GL_TRIANGLES, 0, 6);
+
+	return target->GetInternals().tex;
+}
+
+const PipelineData glib::BloomEffect::Downstream(const PipelineData data)
+{
+	RenderTargetPool* pool = m_Wnd->GetRenderTargetPool();
+	Vec2 size = GetRenderSize(m_TargetSize);
+
+	// The chain replaces the targets, blending would darken it by the alpha of every level
+	OpenGLProxy::Disable(GL_BLEND);
+	OpenGLProxy::BindVertexArray(m_VAO);
+	OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+
+	Vec2 sizes[BLOOM_MAX_ITERATIONS + 1];
+	sizes[0] = Vec2(std::max(1.0f, std::floor(size.x / 2.0f)), std::max(1.0f, std::floor(size.y / 2.0f)));
+
+	m_BrightShd->Use();
+	m_BrightShd->SetFloat("glib_threshold", m_Threshold);
+	unsigned int bloom = Pass(m_BrightShd, data.uI, size, sizes[0]);
+
+	// Each level is released as soon as the next one is drawn, so the chain only holds two targets at a time
+	int levels = 0;
+	int iterations = std::min(std::max(m_Iterations, 0), BLOOM_MAX_ITERATIONS);
+	for (int i = 1; i <= iterations; i++)
+	{
+		Vec2 next = Vec2(std::floor(sizes[i - 1].x / 2.0f), std::floor(sizes[i - 1].y / 2.0f));
+		if (next.x < 2.0f || next.y < 2.0f) break;
+
+		sizes[i] = next;
+		unsigned int down = Pass(m_DownShd, bloom, sizes[i - 1], next);
+		pool->ReleaseTexture(bloom);
+		bloom = down;
+		levels = i;
+	}
+
+	for (int i = levels; i > 0; i--)
+	{
+		unsigned int up = Pass(m_UpShd, bloom, sizes[i], sizes[i - 1]);
+		pool->ReleaseTexture(bloom);
+		bloom = up;
+	}
+
+	OpenGLProxy::Enable(GL_BLEND);
+	OpenGLProxy::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	Framebuffer* target = BindOutput(m_Wnd, size);
+	m_CompositeShd->Use();
+	m_CompositeShd->SetFloat("glib_strength", m_Strength);
+
+	OpenGLProxy::ActiveTexture(GL_TEXTURE1);
+	OpenGLProxy::BindTexture(GL_TEXTURE_2D, bloom);
+	OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+	OpenGLProxy::BindTexture(GL_TEXTURE_2D, data.uI);
+
+	OpenGLProxy::DrawArrays(GL_TRIANGLES, 0, 6);
+
+	// The chain has been drawn, so the next element can reuse it
+	pool->ReleaseTexture(bloom);
+
+	return FinishOutput(m_Wnd, target, data);
+}
+
+bool glib::BloomEffect::CanDrawToWindow() const
+{
+	return GetRenderScale() * pipelineScale == 1.0f;
+}
+
+void glib::BloomEffect::ConstructFBO(Vec2 pos, Vec2 size)
+{
+	ResizeTarget(size);
+}
\ No newline at end of file
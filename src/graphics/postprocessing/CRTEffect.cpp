@@ -2,6 +2,7 @@
 #include "glib/event/EventManager.h"
 #include "glib/window/Window.h"
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 #include <iostream>
 #include <GLFW/glfw3.h>
 
@@ -11,24 +12,20 @@ static const char* VERTEX_SHADER = R"(
 layout(location = 0) in vec3 pos;
 layout(location = 1) in vec2 _texCoord;
 
-out vec2 texCoord;
+out vec2 glib_uv;
 
 void main()
 {
 	gl_Position = vec4(pos, 1.0);
-	texCoord = _texCoord;
+	glib_uv = _texCoord;
 }
 )";
 
-static const char* FRAGMENT_SHADER = R"(
-#version 330 compatibility
+// Samples the input around the curved position, so it can only start a fused pass
+static const char* STAGE_CODE = R"(
+uniform float glib_crt_time;
 
-uniform sampler2D tex;
-uniform float time;
-
-in vec2 texCoord;
-
-vec2 curve(vec2 uv)
+vec2 glib_crt_curve(vec2 uv)
 {
 	uv = (uv - 0.5) * 2.0;
 	uv *= 1.1;	
@@ -38,21 +35,22 @@ vec2 curve(vec2 uv)
 	uv =  uv *0.92 + 0.04;
 	return uv;
 }
-void main()
+vec4 effect(vec2 texCoord, vec4 color)
 {
+    float time = glib_crt_time;
     vec2 q = texCoord;
     vec2 uv = q;
-    uv = curve( uv );
-    vec3 oricol = texture( tex, vec2(q.x,q.y) ).rgb;
+    uv = glib_crt_curve( uv );
+    vec3 oricol = texture( glib_input, vec2(q.x,q.y) ).rgb;
     vec3 col;
 	float x =  sin(0.3*time+uv.y*21.0)*sin(0.7*time+uv.y*29.0)*sin(0.3+0.33*time+uv.y*31.0)*0.0017;
 
-    col.r = texture(tex,vec2(x+uv.x+0.001,uv.y+0.001)).x+0.05;
-    col.g = texture(tex,vec2(x+uv.x+0.000,uv.y-0.002)).y+0.05;
-    col.b = texture(tex,vec2(x+uv.x-0.002,uv.y+0.000)).z+0.05;
-    col.r += 0.08*texture(tex,0.75*vec2(x+0.025, -0.027)+vec2(uv.x+0.001,uv.y+0.001)).x;
-    col.g += 0.05*texture(tex,0.75*vec2(x+-0.022, -0.02)+vec2(uv.x+0.000,uv.y-0.002)).y;
-    col.b += 0.08*texture(tex,0.75*vec2(x+-0.02, -0.018)+vec2(uv.x-0.002,uv.y+0.000)).z;
+    col.r = texture(glib_input,vec2(x+uv.x+0.001,uv.y+0.001)).x+0.05;
+    col.g = texture(glib_input,vec2(x+uv.x+0.000,uv.y-0.002)).y+0.05;
+    col.b = texture(glib_input,vec2(x+uv.x-0.002,uv.y+0.000)).z+0.05;
+    col.r += 0.08*texture(glib_input,0.75*vec2(x+0.025, -0.027)+vec2(uv.x+0.001,uv.y+0.001)).x;
+    col.g += 0.05*texture(glib_input,0.75*vec2(x+-0.022, -0.02)+vec2(uv.x+0.000,uv.y-0.002)).y;
+    col.b += 0.08*texture(glib_input,0.75*vec2(x+-0.02, -0.018)+vec2(uv.x-0.002,uv.y+0.000)).z;
 
     col = clamp(col*0.6+0.4*col*col*1.0,0.0,1.0);
 
@@ -80,7 +78,7 @@ void main()
 	// Remove the next line to stop cross-fade between original and postprocess
 //	col = mix( col, oricol, comp );
 
-    gl_FragColor = vec4(col, texture( tex, vec2(q.x,q.y) ).a);
+    return vec4(col, texture( glib_input, vec2(q.x,q.y) ).a);
 }
 )";
 
@@ -123,8 +121,7 @@ void glib::CRTEffect::Construct(Window* wnd)
 	m_L = new CRTEffect_Listener(this);
 	wnd->GetEventManager().Subscribe(GLIB_EVENT_WINDOW_RESIZE, (EventSubscriber*)m_L);
 
-	m_Size = wnd->GetInitialSize();
-	m_Shd = wnd->LoadShader(VERTEX_SHADER, FRAGMENT_SHADER);
+	m_Shd = wnd->LoadSharedShader(VERTEX_SHADER, EffectStage::BuildShader({ STAGE_CODE }));
 
 	ConstructFBO(glib::Vec2(0.0f, 0.0f), wnd->GetInitialSize());
 
@@ -144,7 +141,7 @@ void glib::CRTEffect::Construct(Window* wnd)
 	glGenVertexArrays(1, &m_VAO);
 	glGenBuffers(1, &m_VBO);
 
-	glBindVertexArray(m_VAO);
+	OpenGLProxy::BindVertexArray(m_VAO);
 
 	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * verticeCount * 3 + sizeof(float) * verticeCount * 2, vertices, GL_STATIC_DRAW);
@@ -156,44 +153,48 @@ void glib::CRTEffect::Construct(Window* wnd)
 	glEnableVertexAttribArray(1);
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	OpenGLProxy::BindVertexArray(0);
 }
 
 const PipelineData glib::CRTEffect::Downstream(const PipelineData data)
 {
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	OpenGLProxy::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	m_FB->Bind();
+	Vec2 size = GetRenderSize(m_TargetSize);
+	Framebuffer* target = BindOutput(m_Wnd, size);
 	m_Shd->Use();
-	m_Shd->SetFloat("time", glfwGetTime());
-
-	glViewport(0, 0, m_Size.x, m_Size.y);
-	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	ApplyStageUniforms(m_Shd);
 
-	glBindTexture(GL_TEXTURE_2D, data.uI);
+	OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+	OpenGLProxy::BindTexture(GL_TEXTURE_2D, data.uI);
 
-	glBindVertexArray(m_VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glBindVertexArray(0);
+	OpenGLProxy::BindVertexArray(m_VAO);
+	OpenGLProxy::DrawArrays(GL_TRIANGLES, 0, 6);
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+	return FinishOutput(m_Wnd, target, data);
+}
 
-	m_FB->Unbind();
+std::string glib::CRTEffect::GetStageCode() const
+{
+	return STAGE_CODE;
+}
 
-	return { data.ptr, m_FB->GetInternals().tex };
+bool glib::CRTEffect::IsNeighbourhoodStage() const
+{
+	return true;
 }
 
-void glib::CRTEffect::ConstructFBO(Vec2 pos, Vec2 size)
+void glib::CRTEffect::ApplyStageUniforms(Shader* shader)
 {
-	m_Wnd->SetToCurrentContext();
-	if (m_FB != nullptr)
-	{
-		delete m_FB;
-	}
+	shader->SetFloat("glib_crt_time", glfwGetTime());
+}
 
-	m_Size = size;
-	m_Pos = pos;
+bool glib::CRTEffect::CanDrawToWindow() const
+{
+	return GetRenderScale() * pipelineScale == 1.0f;
+}
 
-	m_FB = new Framebuffer(FramebufferType::TEXTURE, size);
+void glib::CRTEffect::ConstructFBO(Vec2 pos, Vec2 size)
+{
+	ResizeTarget(size);
 }
@@ -2,6 +2,7 @@
 #include "glib/event/EventManager.h"
 #include "glib/window/Window.h"
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 #include <iostream>
 #include <GLFW/glfw3.h>
 
@@ -11,34 +12,30 @@ static const char* VERTEX_SHADER = R"(
 layout(location = 0) in vec3 pos;
 layout(location = 1) in vec2 _texCoord;
 
-out vec2 texCoord;
+out vec2 glib_uv;
 
 void main()
 {
 	gl_Position = vec4(pos, 1.0);
-	texCoord = _texCoord;
+	glib_uv = _texCoord;
 }
 )";
 
-static const char* FRAGMENT_SHADER = R"(
-#version 330 core
-
-uniform sampler2D tex;
-uniform float strength;
-
-in vec2 texCoord;
+// Samples the input next to uv, so it can only start a fused pass
+static const char* STAGE_CODE = R"(
+uniform float glib_chromatic_strength;
 
-void main()
+vec4 effect(vec2 texCoord, vec4 color)
 {
 vec2 U = texCoord;
-	vec2 R = vec2(-1.0, 1.0), m = vec2(strength, 1.0).xy; 
+	vec2 R = vec2(-1.0, 1.0), m = vec2(glib_chromatic_strength, 1.0).xy; 
 	
     float d = (length(m)<.02) ? .015 : m.x/10.;
  
-	gl_FragColor = vec4( texture(tex,U-d).x,
-              texture(tex,U  ).y,
-              texture(tex,U+d).z,
-              texture(tex, U).a);
+	return vec4( texture(glib_input,U-d).x,
+              texture(glib_input,U  ).y,
+              texture(glib_input,U+d).z,
+              texture(glib_input, U).a);
 }
 )";
 
@@ -74,10 +71,8 @@ glib::ChromaticEffect::~ChromaticEffect()
 
 void glib::ChromaticEffect::SetStrength(float strength)
 {
+	// Applied when the effect is drawn, so it works for a fused shader as well
 	m_Strength = strength;
-	m_Wnd->SetToCurrentContext();
-	m_Shd->Use();
-	m_Shd->SetFloat("strength", strength);
 }
 
 void glib::ChromaticEffect::Construct(Window* wnd)
@@ -90,10 +85,7 @@ void glib::ChromaticEffect::Construct(Window* wnd)
 	m_L = new CRTEffect_Listener(this);
 	wnd->GetEventManager().Subscribe(GLIB_EVENT_WINDOW_RESIZE, (EventSubscriber*)m_L);
 
-	m_Size = wnd->GetInitialSize();
-	m_Shd = wnd->LoadShader(VERTEX_SHADER, FRAGMENT_SHADER);
-	m_Shd->Use();
-	m_Shd->SetFloat("strength", m_Strength);
+	m_Shd = wnd->LoadSharedShader(VERTEX_SHADER, EffectStage::BuildShader({ STAGE_CODE }));
 
 	ConstructFBO(glib::Vec2(0.0f, 0.0f), wnd->GetInitialSize());
 
@@ -113,7 +105,7 @@ void glib::ChromaticEffect::Construct(Window* wnd)
 	glGenVertexArrays(1, &m_VAO);
 	glGenBuffers(1, &m_VBO);
 
-	glBindVertexArray(m_VAO);
+	OpenGLProxy::BindVertexArray(m_VAO);
 
 	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * verticeCount * 3 + sizeof(float) * verticeCount * 2, vertices, GL_STATIC_DRAW);
@@ -125,43 +117,48 @@ void glib::ChromaticEffect::Construct(Window* wnd)
 	glEnableVertexAttribArray(1);
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	OpenGLProxy::BindVertexArray(0);
 }
 
 const PipelineData glib::ChromaticEffect::Downstream(const PipelineData data)
 {
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	OpenGLProxy::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	m_FB->Bind();
+	Vec2 size = GetRenderSize(m_TargetSize);
+	Framebuffer* target = BindOutput(m_Wnd, size);
 	m_Shd->Use();
+	ApplyStageUniforms(m_Shd);
 
-	glViewport(0, 0, m_Size.x, m_Size.y);
-	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-	glBindTexture(GL_TEXTURE_2D, data.uI);
+	OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+	OpenGLProxy::BindTexture(GL_TEXTURE_2D, data.uI);
 
-	glBindVertexArray(m_VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glBindVertexArray(0);
+	OpenGLProxy::BindVertexArray(m_VAO);
+	OpenGLProxy::DrawArrays(GL_TRIANGLES, 0, 6);
 
-	glBindTexture(GL_TEXTURE_2D, 0);
+	return FinishOutput(m_Wnd, target, data);
+}
 
-	m_FB->Unbind();
+std::string glib::ChromaticEffect::GetStageCode() const
+{
+	return STAGE_CODE;
+}
 
-	return { data.ptr, m_FB->GetInternals().tex };
+bool glib::ChromaticEffect::IsNeighbourhoodStage() const
+{
+	return true;
 }
 
-void glib::ChromaticEffect::ConstructFBO(Vec2 pos, Vec2 size)
+void glib::ChromaticEffect::ApplyStageUniforms(Shader* shader)
 {
-	m_Wnd->SetToCurrentContext();
-	if (m_FB != nullptr)
-	{
-		delete m_FB;
-	}
+	shader->SetFloat("glib_chromatic_strength", m_Strength);
+}
 
-	m_Size = size;
-	m_Pos = pos;
+bool glib::ChromaticEffect::CanDrawToWindow() const
+{
+	return GetRenderScale() * pipelineScale == 1.0f;
+}
 
-	m_FB = new Framebuffer(FramebufferType::TEXTURE, size);
+void glib::ChromaticEffect::ConstructFBO(Vec2 pos, Vec2 size)
+{
+	ResizeTarget(size);
 }
@@ -1,5 +1,6 @@
 #include "glib/graphics/postprocessing/CustomShader.h"
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 #include <glib/window/Window.h>
 #include <glib/math/Mat4.h>
 
@@ -22,6 +23,19 @@ using namespace glib;
 
 glib::CustomShader::CustomShader(const std::string& fragmentCode) : PipelineRenderer(VERTEX_SHADER, fragmentCode)
 {
+	m_PooledTarget = true;
+
+	// Stage code gets the same generated main as a fused pass, without its own #version
+	if (fragmentCode.find("vec4 effect(") != std::string::npos)
+	{
+		m_StageCode = fragmentCode;
+		size_t version = m_StageCode.find("#version");
+		if (version != std::string::npos)
+		{
+			m_StageCode.erase(version, m_StageCode.find('\n', version) - version);
+		}
+		m_FragmentCode = EffectStage::BuildShader({ m_StageCode });
+	}
 }
 
 glib::CustomShader::~CustomShader()
@@ -35,7 +49,7 @@ void glib::CustomShader::Construct(Window* wnd)
 	type = GLIB_PE_CUSTOM_SHADER;
 
 	glDeleteBuffers(1, &m_VAO);
-	glDeleteVertexArrays(1, &m_VBO);
+	OpenGLProxy::DeleteVertexArrays(1, &m_VBO);
 
 	float vertices[] = {
 		// first triangle
@@ -53,7 +67,7 @@ void glib::CustomShader::Construct(Window* wnd)
 	glGenVertexArrays(1, &m_VAO);
 	glGenBuffers(1, &m_VBO);
 
-	glBindVertexArray(m_VAO);
+	OpenGLProxy::BindVertexArray(m_VAO);
 
 	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * verticeCount * 3 + sizeof(float) * verticeCount * 2, vertices, GL_STATIC_DRAW);
@@ -65,32 +79,30 @@ void glib::CustomShader::Construct(Window* wnd)
 	glEnableVertexAttribArray(1);
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	OpenGLProxy::BindVertexArray(0);
 }
 
 const glib::PipelineData glib::CustomShader::Downstream(const PipelineData data)
 {
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	OpenGLProxy::Enable(GL_BLEND);
+	OpenGLProxy::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	m_FB->Bind();
+	Vec2 size = GetRenderSize(m_Size);
+	Framebuffer* target = BindOutput(m_Wnd, size);
 	m_Shd->Use();
 
-	glViewport(0, 0, m_Size.x, m_Size.y);
-	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+	OpenGLProxy::BindTexture(GL_TEXTURE_2D, data.uI);
 
-	glBindTexture(GL_TEXTURE_2D, data.uI);
+	OpenGLProxy::BindVertexArray(m_VAO);
+	OpenGLProxy::DrawArrays(GL_TRIANGLES, 0, 6);
 
-	glBindVertexArray(m_VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glBindVertexArray(0);
-
-	glBindTexture(GL_TEXTURE_2D, 0);
-
-	m_FB->Unbind();
+	return FinishOutput(m_Wnd, target, data);
+}
 
-	return { data.ptr, m_FB->GetInternals().tex };
+bool glib::CustomShader::CanDrawToWindow() const
+{
+	return GetRenderScale() * pipelineScale == 1.0f;
 }
 
 void glib::CustomShader::ConstructFBO(Vec2 pos, Vec2 size)
@@ -99,6 +111,22 @@ void glib::CustomShader::ConstructFBO(Vec2 pos, Vec2 size)
 	m_Shd->SetVec2("texSize", size);
 }
 
+std::string glib::CustomShader::GetStageCode() const
+{
+	return m_StageCode;
+}
+
+bool glib::CustomShader::IsNeighbourhoodStage() const
+{
+	return m_StageCode.find("glib_input") != std::string::npos;
+}
+
+void glib::CustomShader::ApplyStageUniforms(Shader* shader)
+{
+	// Custom uniforms are set by the user on GetShader
+	if (shader != m_Shd) m_Shd->CopyUniforms(shader);
+}
+
 Shader* glib::CustomShader::GetShader()
 {
 	return m_Shd;
@@ -0,0 +1,35 @@
+#include "glib/graphics/postprocessing/EffectStage.h"
+
+#include <sstream>
+
+using namespace glib;
+
+std::string glib::EffectStage::BuildShader(const std::vector<std::string>& stages)
+{
+	std::stringstream ss;
+	ss << "#version 330 core\n\n";
+	ss << "uniform sampler2D glib_input;\n";
+	ss << "vec2 glib_tex_size; // Set by main, the input may be smaller than the target with a render scale\n\n";
+	ss << "in vec2 glib_uv;\n";
+	ss << "out vec4 glib_frag_color;\n\n";
+
+	// Every stage calls its entry point effect, so it's renamed per stage
+	for (size_t i = 0; i < stages.size(); i++)
+	{
+		ss << "#define effect glib_effect_" << i << "\n";
+		ss << stages[i] << "\n";
+		ss << "#undef effect\n\n";
+	}
+
+	ss << "void main()\n{\n";
+	ss << "\tglib_tex_size = vec2(textureSize(glib_input, 0));\n";
+	ss << "\tvec4 color = texture(glib_input, glib_uv);\n";
+	for (size_t i = 0; i < stages.size(); i++)
+	{
+		ss << "\tcolor = glib_effect_" << i << "(glib_uv, color);\n";
+	}
+	ss << "\tglib_frag_color = color;\n";
+	ss << "}\n";
+
+	return ss.str();
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "glib/graphics/postprocessing/FusedEffect.h"
+#include "glib/event/EventManager.h"
+#include "glib/window/Window.h"
+#include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
+
+static const char* VERTEX_SHADER = R"(
+#version 330 core
+
+layout(location = 0) in vec3 pos;
+layout(location = 1) in vec2 _texCoord;
+
+out vec2 glib_uv;
+
+void main()
+{
+	gl_Position = vec4(pos, 1.0);
+	glib_uv = _texCoord;
+}
+)";
+
+using namespace glib;
+
+namespace glib
+{
+	class FusedEffect_Listener : public EventSubscriber
+	{
+	private:
+		FusedEffect* m_Parent;
+	public:
+		FusedEffect_Listener(FusedEffect* parent) : m_Parent(parent)
+		{
+		}
+
+		void OnWindowResize(const WindowResizeEvent& event) override
+		{
+			m_Parent->ConstructFBO(Vec2(event.x, event.y), Vec2(event.width, event.height));
+		}
+	};
+}
+
+glib::FusedEffect::FusedEffect(const std::vector<PipelineElement*>& elements) : m_Shd(nullptr), m_Elements(elements)
+{
+	for (PipelineElement* element : elements)
+	{
+		m_Stages.push_back(dynamic_cast<EffectStage*>(element));
+	}
+}
+
+glib::FusedEffect::~FusedEffect()
+{
+	m_Wnd->GetEventManager().Unsubscribe((EventSubscriber*)m_L);
+	delete (FusedEffect_Listener*)m_L;
+	OpenGLProxy::DeleteVertexArrays(1, &m_VAO);
+	glDeleteBuffers(1, &m_VBO);
+}
+
+void glib::FusedEffect::Construct(Window* wnd)
+{
+	type = GLIB_PE_FUSED_EFFECT;
+
+	m_Wnd = wnd;
+	wnd->SetToCurrentContext();
+
+	m_L = new FusedEffect_Listener(this);
+	wnd->GetEventManager().Subscribe(GLIB_EVENT_WINDOW_RESIZE, (EventSubscriber*)m_L);
+
+
+	std::vector<std::string> stages;
+	for (EffectStage* stage : m_Stages)
+	{
+		stages.push_back(stage->GetStageCode());
+	}
+
+	// If the generated shader doesn't link, the effects keep drawing themselves
+	m_Shd = wnd->LoadSharedShader(VERTEX_SHADER, EffectStage::BuildShader(stages));
+	if (m_Shd)
+	{
+		for (size_t i = 0; i < m_Elements.size(); i++)
+		{
+			m_Elements[i]->fused = true;
+			m_Stages[i]->SetFusedShader(m_Shd);
+		}
+	}
+
+	ConstructFBO(glib::Vec2(0.0f, 0.0f), wnd->GetInitialSize());
+
+	float vertices[] = {
+		// first triangle
+		1.0f,  1.0f, 0.0f, 1.0, 1.0,  // top right
+		1.0f,  -1.0f, 0.0f, 1.0, 0.0,  // bottom right
+		-1.0f,  1.0f, 0.0f, 0.0, 1.0, // top left
+		// second triangle
+		1.0f,  -1.0f, 0.0f, 1.0, 0.0, // bottom right
+		-1.0f,  -1.0f, 0.0f, 0.0, 0.0, // bottom left
+		-1.0f,  1.0f, 0.0f,  0.0, 1.0 // top left
+	};
+
+	int verticeCount = 6;
+
+	glGenVertexArrays(1, &m_VAO);
+	glGenBuffers(1, &m_VBO);
+
+	OpenGLProxy::BindVertexArray(m_VAO);
+
+	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * verticeCount * 3 + sizeof(float) * verticeCount * 2, vertices, GL_STATIC_DRAW);
+
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+	glEnableVertexAttribArray(0);
+
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+	glEnableVertexAttribArray(1);
+
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	OpenGLProxy::BindVertexArray(0);
+}
+
+const PipelineData glib::FusedEffect::Downstream(const PipelineData data)
+{
+	if (!m_Shd) return data;
+
+	// A camera excluded from some of the effects gets them one by one, like an unfused pipeline
+	Camera* camera = (Camera*)data.ptr;
+	bool partial = false;
+	for (PipelineElement* element : m_Elements)
+	{
+		if (element->IsExcludedFromCamera(camera))
+		{
+			partial = true;
+			break;
+		}
+	}
+
+	if (partial)
+	{
+		PipelineData result = data;
+		for (PipelineElement* element : m_Elements)
+		{
+			if (element->IsExcludedFromCamera(camera)) continue;
+			result = element->Downstream(result);
+		}
+		return result;
+	}
+
+	OpenGLProxy::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	// The stages were grouped by render scale, so the first one speaks for all of them
+	Vec2 size = m_Elements.front()->GetRenderSize(m_TargetSize);
+	Framebuffer* target = BindOutput(m_Wnd, size);
+	m_Shd->Use();
+	for (EffectStage* stage : m_Stages)
+	{
+		stage->ApplyStageUniforms(m_Shd);
+	}
+
+	OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+	OpenGLProxy::BindTexture(GL_TEXTURE_2D, data.uI);
+
+	OpenGLProxy::BindVertexArray(m_VAO);
+	OpenGLProxy::DrawArrays(GL_TRIANGLES, 0, 6);
+
+	return FinishOutput(m_Wnd, target, data);
+}
+
+bool glib::FusedEffect::CanDrawToWindow() const
+{
+	return m_Elements.front()->GetRenderScale() * pipelineScale == 1.0f;
+}
+
+void glib::FusedEffect::ConstructFBO(Vec2 pos, Vec2 size)
+{
+	ResizeTarget(size);
+}
\ No newline at end of file
@@ -2,10 +2,13 @@
 #include "glib/window/Window.h"
 #include "glib/graphics/pipeline/CameraRenderer.h"
 #include "glib/graphics/pipeline/WindowRenderer.h"
+#include "glib/graphics/postprocessing/BloomEffect.h"
 #include "glib/graphics/postprocessing/CRTEffect.h"
 #include "glib/graphics/postprocessing/ChromaticEffect.h"
 #include "glib/graphics/postprocessing/SpeedLinesEffect.h"
 #include "glib/graphics/postprocessing/CustomShader.h"
+#include "glib/graphics/postprocessing/FusedEffect.h"
+#include <algorithm>
 #include <iostream>
 
 using namespace glib;
@@ -15,7 +18,7 @@ PostProcessing::Builder glib::PostProcessing::NewBuilder(Window* wnd)
 	return Builder(wnd);
 }
 
-glib::PostProcessing::Builder::Builder(Window* wnd) : m_Built(false), m_Wnd(wnd)
+glib::PostProcessing::Builder::Builder(Window* wnd) : m_Built(false), m_Wnd(wnd), m_Fusion(true)
 {
 	wnd->SetToCurrentContext();
 	RenderPipeline* p = new RenderPipeline(wnd);
@@ -25,37 +28,90 @@ glib::PostProcessing::Builder::Builder(Window* wnd) : m_Built(false), m_Wnd(wnd)
 
 glib::PostProcessing::Builder::~Builder()
 {
-	if (!m_Built) delete m_Pipeline;
+	if (m_Built) return;
+
+	// The effects only clean up after Construct, so the pipeline takes them before it's deleted
+	for (PipelineElement* effect : m_Effects)
+	{
+		m_Pipeline->AddElement(effect);
+	}
+	delete m_Pipeline;
 }
 
 PostProcessing::Builder& glib::PostProcessing::Builder::AddEffect(uint64_t effect, const ShaderEffectParams& params)
 {
+	PipelineElement* element = nullptr;
 	if (effect & GLIB_PP_BLOOM)
 	{
-
+		element = new BloomEffect((const BloomParams&)params);
 	}
 	else if (effect & GLIB_PP_CRT_TV)
 	{
-		m_Pipeline->AddElement(new CRTEffect);
+		element = new CRTEffect;
 	}
 	else if (effect & GLIB_PP_CHROMATIC)
 	{
-		m_Pipeline->AddElement(new ChromaticEffect((const ChromaticParams&)params));
+		element = new ChromaticEffect((const ChromaticParams&)params);
 	}
 	else if (effect & GLIB_PP_SPEED_LINES)
 	{
-		m_Pipeline->AddElement(new SpeedLinesEffect);
+		element = new SpeedLinesEffect;
 	}
 	else if (effect & GLIB_PP_CUSTOM_SHADER)
 	{
-		m_Pipeline->AddElement(new CustomShader(((const CustomShaderParams&)params).fragmentCode));
+		element = new CustomShader(((const CustomShaderParams&)params).fragmentCode);
+	}
+
+	if (element)
+	{
+		element->SetRenderScale(params.renderScale);
+		m_Effects.push_back(element);
 	}
 	return *this;
 }
 
+PostProcessing::Builder& glib::PostProcessing::Builder::SetFusion(bool toggle)
+{
+	m_Fusion = toggle;
+	return *this;
+}
+
 RenderPipeline* glib::PostProcessing::Builder::Build()
 {
 	m_Built = true;
+
+	size_t i = 0;
+	while (i < m_Effects.size())
+	{
+		// A pass goes on while the next stage only needs the color at its own pixel and renders at the same scale.
+		// The same stage twice would share its uniforms, so it starts a new pass as well.
+		std::vector<PipelineElement*> group;
+		std::vector<std::string> codes;
+		for (size_t j = i; m_Fusion && j < m_Effects.size(); j++)
+		{
+			EffectStage* stage = dynamic_cast<EffectStage*>(m_Effects[j]);
+			if (!stage) break;
+
+			std::string code = stage->GetStageCode();
+			if (code.empty()) break;
+			if (!group.empty() && (stage->IsNeighbourhoodStage() || m_Effects[j]->GetRenderScale() != group.front()->GetRenderScale()
+				|| std::find(codes.begin(), codes.end(), code) != codes.end())) break;
+
+			group.push_back(m_Effects[j]);
+			codes.push_back(code);
+		}
+
+		if (group.size() > 1) m_Pipeline->AddElement(new FusedEffect(group));
+
+		size_t count = std::max(group.size(), (size_t)1);
+		for (size_t j = i; j < i + count; j++)
+		{
+			m_Pipeline->AddElement(m_Effects[j]);
+		}
+		i += count;
+	}
+	m_Effects.clear();
+
 	m_Pipeline->AddElement(new WindowRenderer);
 	return m_Pipeline;
 }
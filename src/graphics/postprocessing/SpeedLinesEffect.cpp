@@ -2,6 +2,7 @@
 #include "glib/event/EventManager.h"
 #include "glib/window/Window.h"
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 #include <iostream>
 #include <GLFW/glfw3.h>
 
@@ -11,27 +12,23 @@ static const char* VERTEX_SHADER = R"(
 layout(location = 0) in vec3 pos;
 layout(location = 1) in vec2 _texCoord;
 
-out vec2 texCoord;
+out vec2 glib_uv;
 
 void main()
 {
 	gl_Position = vec4(pos, 1.0);
-	texCoord = _texCoord;
+	glib_uv = _texCoord;
 }
 )";
 
-static const char* FRAGMENT_SHADER = R"(
-#version 330 core
-
-uniform sampler2D tex;
-uniform float _time;
-uniform float _radius;
-uniform float _edge;
-uniform vec4 _color;
-
-in vec2 texCoord;
+// Only adds to the color at uv, so it can be fused after any other stage
+static const char* STAGE_CODE = R"(
+uniform float glib_speed_lines_time;
+uniform float glib_speed_lines_radius;
+uniform float glib_speed_lines_edge;
+uniform vec4 glib_speed_lines_color;
 
-vec3 random3(vec3 c) {
+vec3 glib_speed_lines_random3(vec3 c) {
 	float j = 4096.0*sin(dot(c,vec3(17.0, 59.4, 15.0)));
 	vec3 r;
 	r.z = fract(512.0*j);
@@ -42,7 +39,7 @@ vec3 random3(vec3 c) {
 	return r-0.5;
 }
 
-float simplex3d(vec3 p) {
+float glib_speed_lines_simplex3d(vec3 p) {
 	 vec3 s = floor(p + dot(p, vec3(0.3333333)));
 	 vec3 x = p - s + dot(s, vec3(0.1666667));
 	 vec3 e = step(vec3(0.0), x - x.yzx);
@@ -57,31 +54,31 @@ float simplex3d(vec3 p) {
 	 w.z = dot(x2, x2);
 	 w.w = dot(x3, x3);
 	 w = max(0.6 - w, 0.0);
-	 d.x = dot(random3(s), x);
-	 d.y = dot(random3(s + i1), x1);
-	 d.z = dot(random3(s + i2), x2);
-	 d.w = dot(random3(s + 1.0), x3);
+	 d.x = dot(glib_speed_lines_random3(s), x);
+	 d.y = dot(glib_speed_lines_random3(s + i1), x1);
+	 d.z = dot(glib_speed_lines_random3(s + i2), x2);
+	 d.w = dot(glib_speed_lines_random3(s + 1.0), x3);
 	 w *= w;
 	 w *= w;
 	 d *= w;
 	 return dot(d, vec4(52.0));
 }
 
-void main()
+vec4 effect(vec2 texCoord, vec4 color)
 {
 	vec2 iResolution = vec2(1.0, 1.0);
-    float time = _time * 2.;
+    float time = glib_speed_lines_time * 2.;
     float scale = 50.0;
     vec2 uv = (texCoord.xy*2. - iResolution.xy) / iResolution.y * 0.5;
     vec2 p = vec2(0.5*iResolution.x/iResolution.y, 0.5) + normalize(uv) * min(length(uv), 0.05);
     vec3 p3 = scale*0.25*vec3(p.xy, 0) + vec3(0, 0, time*0.025);
-    float noise = simplex3d(p3 * 32.0) * 0.5 + 0.5;
-    float dist = abs(clamp(length(uv)/_radius, 0.0, 1.0)*noise*2.-1.);
-    float stepped = smoothstep(_edge-.5,_edge+.5, noise * (1.0-pow(dist, 4.0)));
-    float final = smoothstep(_edge - 0.05, _edge + 0.05, noise*stepped);
+    float noise = glib_speed_lines_simplex3d(p3 * 32.0) * 0.5 + 0.5;
+    float dist = abs(clamp(length(uv)/glib_speed_lines_radius, 0.0, 1.0)*noise*2.-1.);
+    float stepped = smoothstep(glib_speed_lines_edge-.5,glib_speed_lines_edge+.5, noise * (1.0-pow(dist, 4.0)));
+    float final = smoothstep(glib_speed_lines_edge - 0.05, glib_speed_lines_edge + 0.05, noise*stepped);
     
     
-	gl_FragColor = vec4(_color.rgb * final, 0.0) + texture(tex, texCoord);
+	return vec4(glib_speed_lines_color.rgb * final, 0.0) + color;
 }
 )";
 
@@ -117,25 +114,16 @@ glib::SpeedLinesEffect::~SpeedLinesEffect()
 void glib::SpeedLinesEffect::SetRadius(float radius)
 {
 	m_Radius = radius;
-	m_Wnd->SetToCurrentContext();
-	m_Shd->Use();
-	m_Shd->SetFloat("_radius", radius);
 }
 
 void glib::SpeedLinesEffect::SetEdge(float edge)
 {
 	m_Edge = edge;
-	m_Wnd->SetToCurrentContext();
-	m_Shd->Use();
-	m_Shd->SetFloat("_edge", edge);
 }
 
 void glib::SpeedLinesEffect::SetColor(const Color& color)
 {
 	m_Color = color;
-	m_Wnd->SetToCurrentContext();
-	m_Shd->Use();
-	m_Shd->SetColor("_color", color);
 }
 
 void glib::SpeedLinesEffect::Construct(Window* wnd)
@@ -148,12 +136,7 @@ void glib::SpeedLinesEffect::Construct(Window* wnd)
 	m_L = new SpeedLinesEffect_Listener(this);
 	wnd->GetEventManager().Subscribe(GLIB_EVENT_WINDOW_RESIZE, (EventSubscriber*)m_L);
 
-	m_Size = wnd->GetInitialSize();
-	m_Shd = wnd->LoadShader(VERTEX_SHADER, FRAGMENT_SHADER);
-	m_Shd->Use();
-	m_Shd->SetFloat("_radius", 12.0f);
-	m_Shd->SetFloat("_edge", 0.3f);
-	m_Shd->SetColor("_color", { 1.0f, 1.0f, 1.0f, 1.0f });
+	m_Shd = wnd->LoadSharedShader(VERTEX_SHADER, EffectStage::BuildShader({ STAGE_CODE }));
 	m_Radius = 12.0f;
 	m_Edge = 0.3f;
 	m_Color = { 1.0f, 1.0f, 1.0f, 1.0f };
@@ -176,7 +159,7 @@ void glib::SpeedLinesEffect::Construct(Window* wnd)
 	glGenVertexArrays(1, &m_VAO);
 	glGenBuffers(1, &m_VBO);
 
-	glBindVertexArray(m_VAO);
+	OpenGLProxy::BindVertexArray(m_VAO);
 
 	glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(float) * verticeCount * 3 + sizeof(float) * verticeCount * 2, vertices, GL_STATIC_DRAW);
@@ -188,44 +171,51 @@ void glib::SpeedLinesEffect::Construct(Window* wnd)
 	glEnableVertexAttribArray(1);
 
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	OpenGLProxy::BindVertexArray(0);
 }
 
 const PipelineData glib::SpeedLinesEffect::Downstream(const PipelineData data)
 {
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	OpenGLProxy::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-	m_FB->Bind();
+	Vec2 size = GetRenderSize(m_TargetSize);
+	Framebuffer* target = BindOutput(m_Wnd, size);
 	m_Shd->Use();
-	m_Shd->SetFloat("_time", glfwGetTime());
+	ApplyStageUniforms(m_Shd);
 
-	glViewport(0, 0, m_Size.x, m_Size.y);
-	glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+	OpenGLProxy::BindTexture(GL_TEXTURE_2D, data.uI);
 
-	glBindTexture(GL_TEXTURE_2D, data.uI);
+	OpenGLProxy::BindVertexArray(m_VAO);
+	OpenGLProxy::DrawArrays(GL_TRIANGLES, 0, 6);
 
-	glBindVertexArray(m_VAO);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
-	glBindVertexArray(0);
-
-	glBindTexture(GL_TEXTURE_2D, 0);
+	return FinishOutput(m_Wnd, target, data);
+}
 
-	m_FB->Unbind();
+std::string glib::SpeedLinesEffect::GetStageCode() const
+{
+	return STAGE_CODE;
+}
 
-	return { data.ptr, m_FB->GetInternals().tex };
+bool glib::SpeedLinesEffect::IsNeighbourhoodStage() const
+{
+	return false;
 }
 
-void glib::SpeedLinesEffect::ConstructFBO(Vec2 pos, Vec2 size)
+void glib::SpeedLinesEffect::ApplyStageUniforms(Shader* shader)
 {
-	m_Wnd->SetToCurrentContext();
-	if (m_FB != nullptr)
-	{
-		delete m_FB;
-	}
+	shader->SetFloat("glib_speed_lines_time", glfwGetTime());
+	shader->SetFloat("glib_speed_lines_radius", m_Radius);
+	shader->SetFloat("glib_speed_lines_edge", m_Edge);
+	shader->SetColor("glib_speed_lines_color", m_Color);
+}
 
-	m_Size = size;
-	m_Pos = pos;
+bool glib::SpeedLinesEffect::CanDrawToWindow() const
+{
+	return GetRenderScale() * pipelineScale == 1.0f;
+}
 
-	m_FB = new Framebuffer(FramebufferType::TEXTURE, size);
+void glib::SpeedLinesEffect::ConstructFBO(Vec2 pos, Vec2 size)
+{
+	ResizeTarget(size);
 }
@@ -1,8 +1,10 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include "glib/graphics/video/VideoPlayer.h"
+#include "glib/math/Affine2D.h"
 
 #include <iostream>
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 #include <thread>
 #include <chrono>
 #define STB_IMAGE_WRITE_IMPLEMENTATION
@@ -157,7 +159,7 @@ namespace glib
 		{
 			for (int i = 0; i < FRAME_BUF_SIZE; i++)
 			{
-				glDeleteTextures(1, &buf[i].texture);
+				OpenGLProxy::DeleteTextures(1, &buf[i].texture);
 			}
 		}
 
@@ -242,7 +244,7 @@ namespace glib
 					int64_t timestamp_ms = av_rescale_q(avFrame->pts, time_base, { 1, 1000 });
 					frame.time = timestamp_ms;
 
-					glBindTexture(GL_TEXTURE_2D, frame.texture);
+					OpenGLProxy::BindTexture(GL_TEXTURE_2D, frame.texture);
 
 					sws_scale_frame(m_SWSCtx, m_ConvertedFrame, avFrame);
 
@@ -263,7 +265,7 @@ namespace glib
 					glGenerateMipmap(GL_TEXTURE_2D);
 				}
 
-				glBindTexture(GL_TEXTURE_2D, 0);
+				OpenGLProxy::BindTexture(GL_TEXTURE_2D, 0);
 				m_FinishedReading = false;
 			}
 		}
@@ -737,6 +739,7 @@ glib::VideoPlayer::VideoPlayer(const std::string& path)
 	: pos(Vec2(0.0f, 0.0f)), size(Vec2(0.0f, 0.0f)), scale(Vec2(1.0f, 1.0f)), rotation(0.0f)
 {
 	visible = true;
+	kind = GLIB_DRAWABLE_VIDEO_PLAYER;
 	impl = new VideoPlayerImpl(path);
 }
 
@@ -767,7 +770,14 @@ void glib::VideoPlayer::Stop()
 
 void glib::VideoPlayer::Draw()
 {
-	glBindTexture(GL_TEXTURE_2D, impl->m_CurrentTexture);
+	OpenGLProxy::BindTexture(GL_TEXTURE_2D, impl->m_CurrentTexture);
+}
+
+bool glib::VideoPlayer::GetBounds(const Vec2& cameraPos, float zoom, Rect& bounds)
+{
+	// Same transform as CameraRenderer::DrawVideoPlayer (video players don't scroll with the camera)
+	bounds = MakeSpriteTransform(pos, size, scale, Vec2(0.0f, 0.0f), Vec2(0.0f, 0.0f), rotation).GetQuadBounds();
+	return true;
 }
 
 void glib::VideoPlayer::Update(float delta)
@@ -14,3 +14,8 @@ float glib::Rect::Distance(const Rect& other)
 {
 	return 0.0f;
 }
+
+bool glib::Rect::Overlaps(const Rect& other) const
+{
+	return x <= other.x + other.w && x + w >= other.x && y <= other.y + other.h && y + h >= other.y;
+}
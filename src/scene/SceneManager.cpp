@@ -1,9 +1,12 @@
 #include "glib/scene/SceneManager.h"
 #include <iostream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 using namespace glib;
 
-glib::SceneManager::SceneManager(Instance* instance, Window* wnd) : m_Last(0.0), m_MaxFPS(60.0f)
+glib::SceneManager::SceneManager(Instance* instance, Window* wnd) : m_Last(0.0), m_MaxFPS(60.0f), m_RenderThread(false)
 {
 	m_Instance = instance;
 	m_Wnd = wnd;
@@ -43,6 +46,12 @@ void glib::SceneManager::Run(float maxFPS)
 {
 	m_MaxFPS = maxFPS;
 
+	if (m_RenderThread)
+	{
+		RunThreaded();
+		return;
+	}
+
 	double last = m_Instance->GetTime() * 1000.0f;
 	while (m_Wnd->IsOpen())
 	{
@@ -65,3 +74,91 @@ void glib::SceneManager::SetMaxFPS(float maxFPS)
 {
 	m_MaxFPS = maxFPS;
 }
+
+void glib::SceneManager::SetRenderThread(bool toggle)
+{
+	m_RenderThread = toggle;
+}
+
+void glib::SceneManager::RunThreaded()
+{
+	// Two packets, so one can be built while the other one is drawn
+	FramePacket packets[2];
+	std::mutex mutex;
+	std::condition_variable cv;
+	int pending = -1;
+	int drawing = -1;
+	bool running = true;
+
+	// The context moves between the threads from now on
+	m_Wnd->SetThreaded(true);
+
+	std::thread renderThread([&]()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true)
+		{
+			cv.wait(lock, [&]() { return pending != -1 || !running; });
+			if (pending == -1) break;
+
+			drawing = pending;
+			pending = -1;
+			cv.notify_all();
+
+			lock.unlock();
+			m_Wnd->DrawFramePacket(packets[drawing]);
+			lock.lock();
+
+			drawing = -1;
+			cv.notify_all();
+		}
+	});
+
+	int next = 0;
+	double last = m_Instance->GetTime() * 1000.0f;
+	while (m_Wnd->IsOpen())
+	{
+		double now = m_Instance->GetTime() * 1000.0f;
+		if (now >= last + 1000.0f / m_MaxFPS)
+		{
+			float delta = now - last;
+			last = now;
+			m_Wnd->UpdateEvents(delta);
+
+			Update(delta);
+
+			m_Wnd->Update(delta);
+
+			// Every SetToCurrentContext needs a SetNotToCurrentContext, a context kept across frames blocks the render thread
+			if (m_Wnd->HasExplicitContextLock())
+			{
+				std::cout << "glib Error: The context is still locked by SetToCurrentContext at the end of the update, the render thread can't draw" << std::endl;
+			}
+
+			{
+				// At most one frame ahead: the last packet has to be picked up and this one can't still be drawn
+				std::unique_lock<std::mutex> lock(mutex);
+				cv.wait(lock, [&]() { return pending == -1 && drawing != next; });
+			}
+
+			m_Wnd->BuildFramePacket(packets[next]);
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				pending = next;
+			}
+			cv.notify_all();
+
+			next = 1 - next;
+		}
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		running = false;
+	}
+	cv.notify_all();
+	renderThread.join();
+
+	m_Wnd->SetThreaded(false);
+}
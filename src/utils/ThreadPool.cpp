@@ -0,0 +1,152 @@
+#include "glib/utils/ThreadPool.h"
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace glib
+{
+	class ThreadPoolImpl
+	{
+	private:
+		std::vector<std::thread> m_Threads;
+		std::deque<std::function<void()>> m_Jobs;
+		std::mutex m_Mutex;
+		std::condition_variable m_JobAvailable;
+		bool m_Running;
+	public:
+		ThreadPoolImpl(unsigned int threads) : m_Running(true)
+		{
+			if (threads == 0)
+			{
+				unsigned int hardware = std::thread::hardware_concurrency();
+				threads = hardware > 1 ? hardware - 1 : 1;
+			}
+
+			for (unsigned int i = 0; i < threads; i++)
+			{
+				m_Threads.emplace_back([this]() { Work(); });
+			}
+		}
+
+		~ThreadPoolImpl()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Running = false;
+			}
+			m_JobAvailable.notify_all();
+
+			for (std::thread& thread : m_Threads)
+			{
+				thread.join();
+			}
+		}
+
+		void Work()
+		{
+			while (true)
+			{
+				std::function<void()> job;
+				{
+					std::unique_lock<std::mutex> lock(m_Mutex);
+					m_JobAvailable.wait(lock, [this]() { return !m_Jobs.empty() || !m_Running; });
+					if (m_Jobs.empty()) return;
+
+					job = std::move(m_Jobs.front());
+					m_Jobs.pop_front();
+				}
+				job();
+			}
+		}
+
+		void ParallelFor(size_t count, size_t minChunk, const std::function<void(size_t begin, size_t end)>& func)
+		{
+			if (count == 0) return;
+			if (minChunk == 0) minChunk = 1;
+
+			// One chunk per worker plus one for the calling thread, rounded up to whole multiples of minChunk
+			size_t parts = m_Threads.size() + 1;
+			size_t chunk = (count + parts - 1) / parts;
+			chunk = (chunk + minChunk - 1) / minChunk * minChunk;
+
+			size_t chunks = (count + chunk - 1) / chunk;
+			if (chunks == 1)
+			{
+				func(0, count);
+				return;
+			}
+
+			std::mutex doneMutex;
+			std::condition_variable doneCv;
+			size_t remaining = chunks - 1;
+
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				for (size_t i = 1; i < chunks; i++)
+				{
+					size_t begin = i * chunk;
+					size_t end = begin + chunk < count ? begin + chunk : count;
+
+					m_Jobs.push_back([&, begin, end]()
+					{
+						func(begin, end);
+
+						std::lock_guard<std::mutex> doneLock(doneMutex);
+						if (--remaining == 0) doneCv.notify_one();
+					});
+				}
+			}
+			m_JobAvailable.notify_all();
+
+			// The calling thread takes the first chunk instead of just waiting
+			func(0, chunk);
+
+			std::unique_lock<std::mutex> lock(doneMutex);
+			doneCv.wait(lock, [&]() { return remaining == 0; });
+		}
+
+		void Enqueue(const std::function<void()>& job)
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_Jobs.push_back(job);
+			}
+			m_JobAvailable.notify_one();
+		}
+
+		unsigned int GetThreadCount() const
+		{
+			return (unsigned int)m_Threads.size();
+		}
+	};
+}
+
+using namespace glib;
+
+glib::ThreadPool::ThreadPool(unsigned int threads)
+{
+	impl = new ThreadPoolImpl(threads);
+}
+
+glib::ThreadPool::~ThreadPool()
+{
+	delete impl;
+}
+
+void glib::ThreadPool::ParallelFor(size_t count, size_t minChunk, const std::function<void(size_t begin, size_t end)>& func)
+{
+	impl->ParallelFor(count, minChunk, func);
+}
+
+void glib::ThreadPool::Enqueue(const std::function<void()>& job)
+{
+	impl->Enqueue(job);
+}
+
+unsigned int glib::ThreadPool::GetThreadCount() const
+{
+	return impl->GetThreadCount();
+}
\ No newline at end of file
@@ -3,9 +3,18 @@
 #include "glib/graphics/camera/Camera.h"
 #include "glib/glibError.h"
 #include "glib/graphics/Shader.h"
+#include "glib/graphics/TextureAtlas.h"
+#include "glib/graphics/Sprite.h"
+#include "glib/graphics/Text.h"
+#include "glib/framebuffer/RenderTargetPool.h"
+#include "glib/backend/ProgramCache.h"
+#include "glib/backend/StreamBuffer.h"
+#include "glib/graphics/TextureRequest.h"
+#include "glib/utils/ThreadPool.h"
 
 #include <vector>
 #include <glad/glad.h>
+#include "glib/backend/OpenGLProxy.h"
 #include <GLFW/glfw3.h>
 #include <sstream>
 #include <fstream>
@@ -13,6 +22,14 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 #include <map>
+#include <unordered_map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <memory>
+
+#define GLIB_TEXTURE_UPLOAD_BUDGET (4 * 1024 * 1024) // Bytes uploaded per frame by LoadTextureAsync
+#define GLIB_TEXTURE_DECODE_THREADS 2
 
 extern int __GLIB_ERROR_CODE;
 extern void glib_print_error();
@@ -94,6 +111,54 @@ namespace glib
 		Camera* m_StaticCamera;
 		std::vector<Camera*> m_DrawCameras;
 		std::map<std::string, Model*> m_Models;
+		bool m_UseAtlas;
+		int m_AtlasThreshold;
+		int m_AtlasPageSize;
+		TextureAtlas* m_Atlas = nullptr;
+		TextureAtlas* m_PixelartAtlas = nullptr;
+		mutable std::recursive_mutex m_ContextMutex;
+		mutable int m_ContextDepth = 0;
+		mutable std::atomic<std::thread::id> m_ContextOwner;
+		bool m_ExplicitLock = false; // Locked by SetToCurrentContext
+		bool m_Threaded = false;
+		RenderTargetPool* m_TargetPool = nullptr;
+		ProgramCache* m_ProgramCache = nullptr;
+
+		// A texture from LoadTextureAsync, decoded by m_Decoder and then uploaded a few rows per frame
+		struct PendingTexture
+		{
+			std::shared_ptr<TextureRequest> request;
+			bool pixelart = false;
+			std::vector<TextureCallback> callbacks;
+			std::atomic<bool> decoded{ false };
+			ImageData image = {}; // Written by the worker before decoded is set
+			std::string error;
+			GLuint id = 0;
+			int row = 0;
+			Texture* texture = nullptr;
+		};
+
+		std::vector<std::shared_ptr<PendingTexture>> m_PendingTextures;
+		ThreadPool* m_Decoder = nullptr;
+		StreamBuffer* m_UploadBuffer = nullptr;
+		size_t m_UploadBudget = GLIB_TEXTURE_UPLOAD_BUDGET;
+		std::unordered_map<std::string, Shader*> m_ShadersBySource; // Key is the vertex and fragment code separated by \0
+
+		// Keeps the context current on this thread for its lifetime
+		struct ContextLock
+		{
+			const WindowImpl* wnd;
+
+			ContextLock(const WindowImpl* wnd) : wnd(wnd)
+			{
+				wnd->LockContext();
+			}
+
+			~ContextLock()
+			{
+				wnd->UnlockContext();
+			}
+		};
 	public:
 		Vec2 m_ViewportPos;
 		Vec2 m_ViewportSize;
@@ -108,6 +173,13 @@ namespace glib
 			m_Height = height;
 
 			m_ManageAssets = params.manageAssets;
+			m_UseAtlas = params.textureAtlas;
+			m_AtlasThreshold = params.textureAtlasThreshold;
+			m_AtlasPageSize = params.textureAtlasPageSize;
+			if (!params.shaderCacheDirectory.empty())
+			{
+				m_ProgramCache = new ProgramCache(params.shaderCacheDirectory);
+			}
 
 			glfwDefaultWindowHints();
 			glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
@@ -120,6 +192,7 @@ namespace glib
 
 			m_Handle = glfwCreateWindow(width, height, title.c_str(), NULL, NULL);
 			glfwMakeContextCurrent(m_Handle);
+			OpenGLProxy::MakeCurrent(m_Handle);
 			glfwSwapInterval(0);
 
 			glfwSetKeyCallback(m_Handle, _glfw_key_func);
@@ -136,10 +209,11 @@ namespace glib
 
 			gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
 
-			glEnable(GL_TEXTURE_2D);
-			glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-			glEnable(GL_MULTISAMPLE);
+			OpenGLProxy::Enable(GL_TEXTURE_2D);
+			OpenGLProxy::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			OpenGLProxy::Enable(GL_MULTISAMPLE);
 
+			m_TargetPool = new RenderTargetPool();
 			m_Pipeline = m_Instance->CreateDefaultPipeline(m_Wnd);
 			m_Cameras.push_back(new Camera(GetInitialSize()));
 
@@ -170,9 +244,24 @@ namespace glib
 			{
 				delete cam;
 			}
+			delete m_Decoder; // Waits for the images that are still being decoded
+			{
+				ContextLock lock(this);
+				for (const std::shared_ptr<PendingTexture>& pending : m_PendingTextures)
+				{
+					if (pending->image.data != nullptr) stbi_image_free(pending->image.data);
+					if (pending->id != 0) OpenGLProxy::DeleteTextures(1, &pending->id);
+				}
+				delete m_UploadBuffer;
+			}
 			ClearCaches(true);
+
+			delete m_Atlas;
+			delete m_PixelartAtlas;
 			
 			delete m_Pipeline;
+			delete m_TargetPool;
+			delete m_ProgramCache;
 
 			glfwDestroyWindow(m_Handle);
 		}
@@ -199,16 +288,23 @@ namespace glib
 			return m_Pipeline;
 		}
 
+		RenderTargetPool* GetRenderTargetPool()
+		{
+			return m_TargetPool;
+		}
+
 		void Draw() const
 		{
-			glfwMakeContextCurrent(m_Handle);
+			ContextLock lock(this);
 
-			glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-			glClear(GL_COLOR_BUFFER_BIT);
+			OpenGLProxy::ClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+			OpenGLProxy::Clear(GL_COLOR_BUFFER_BIT);
 
 			m_Pipeline->Flush(m_DrawCameras);
+			m_TargetPool->EndFrame();
 
 			glfwSwapBuffers(m_Handle);
+			OpenGLProxy::EndFrame();
 		}
 
 		bool IsOpen() const
@@ -218,17 +314,20 @@ namespace glib
 		
 		void Update(float delta)
 		{
-			glfwMakeContextCurrent(m_Handle);
+			// Only the texture uploads need the context, so the rest runs while a render thread is still drawing
 			for (Camera* camera : m_DrawCameras)
 			{
 				camera->Update(delta);
 			}
 			m_Pipeline->Update(delta);
 			m_SoundManager.Update();
+			ProcessTextureUploads();
 		}
 
 		void UpdateEvents(float delta)
 		{
+			// Resize events rebuild framebuffers
+			ContextLock lock(this);
 			glfwPollEvents();
 			if (glfwWindowShouldClose(m_Handle))
 			{
@@ -236,7 +335,48 @@ namespace glib
 			}
 		}
 
-		Shader* LoadShader(const std::string& vertexCode, const std::string& fragmentCode)
+		Shader* LoadShader(const std::string& vertexCode, const std::string& fragmentCode, bool shared)
+		{
+			ContextLock lock(this);
+
+			// Built-in elements often ask for the same program and set all of their uniforms before drawing.
+			// Shaders of the user keep their own uniforms, so they always get a program of their own.
+			std::string key;
+			if (m_ManageAssets && shared)
+			{
+				key.reserve(vertexCode.size() + fragmentCode.size() + 1);
+				key.append(vertexCode).push_back('\0');
+				key.append(fragmentCode);
+
+				auto it = m_ShadersBySource.find(key);
+				if (it != m_ShadersBySource.end()) return it->second;
+			}
+
+			GLuint id = m_ProgramCache ? m_ProgramCache->Load(vertexCode, fragmentCode) : 0;
+			if (id == 0)
+			{
+				id = CompileProgram(vertexCode, fragmentCode);
+				if (id == 0) return nullptr;
+
+				if (m_ProgramCache)
+				{
+					m_ProgramCache->Store(id, vertexCode, fragmentCode);
+				}
+			}
+
+			Shader* shd = new Shader(id);
+
+			if (m_ManageAssets)
+			{
+				m_Shaders.push_back(shd);
+				if (shared) m_ShadersBySource.insert({ key, shd });
+			}
+
+			return shd;
+		}
+
+		// Returns 0 if the program doesn't link
+		GLuint CompileProgram(const std::string& vertexCode, const std::string& fragmentCode)
 		{
 			int success;
 			char infoLog[1024];
@@ -273,10 +413,17 @@ namespace glib
 			}
 
 			id = glCreateProgram();
+			if (m_ProgramCache)
+			{
+				glProgramParameteri(id, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+			}
 			glAttachShader(id, vertex);
 			glAttachShader(id, fragment);
 			glLinkProgram(id);
 
+			glDeleteShader(vertex);
+			glDeleteShader(fragment);
+
 			glGetProgramiv(id, GL_LINK_STATUS, &success);
 			if (!success)
 			{
@@ -284,20 +431,11 @@ namespace glib
 				__GLIB_ERROR_CODE = GLIB_FAIL_SHADER_LINK;
 				glib_print_error();
 				std::cout << infoLog << std::endl;
-				return nullptr;
-			}
-
-			glDeleteShader(vertex);
-			glDeleteShader(fragment);
-
-			Shader* shd = new Shader(id);
-
-			if (m_ManageAssets)
-			{
-				m_Shaders.push_back(shd);
+				OpenGLProxy::DeleteProgram(id);
+				return 0;
 			}
 
-			return shd;
+			return id;
 		}
 
 		Camera* GetDefaultCamera()
@@ -329,7 +467,7 @@ namespace glib
 				return nullptr;
 			}
 
-			Texture* tex = LoadTextureFromRawData({ numChannels, width, height, data }, pixelart);
+			Texture* tex = CreateTexture({ numChannels, width, height, data }, pixelart);
 
 			if (m_ManageAssets)
 			{
@@ -340,6 +478,202 @@ namespace glib
 			return tex;
 		}
 
+		std::shared_ptr<TextureRequest> LoadTextureAsync(const std::string& path, bool pixelart, const TextureCallback& callback)
+		{
+			// Already loading, the callback is just added to the running request
+			for (const std::shared_ptr<PendingTexture>& pending : m_PendingTextures)
+			{
+				if (pending->texture == nullptr && pending->request->GetPath() == path && pending->pixelart == pixelart)
+				{
+					if (callback) pending->callbacks.push_back(callback);
+					return pending->request;
+				}
+			}
+
+			std::shared_ptr<PendingTexture> pending = std::make_shared<PendingTexture>();
+			pending->request = std::make_shared<TextureRequest>(path);
+			pending->pixelart = pixelart;
+			if (callback) pending->callbacks.push_back(callback);
+			m_PendingTextures.push_back(pending);
+
+			// The callback of a cached texture still waits for the next update, so it always runs at the same point in the frame
+			auto it = m_Textures.find(path);
+			if (it != m_Textures.end())
+			{
+				pending->texture = it->second;
+				pending->request->Finish(it->second);
+				return pending->request;
+			}
+
+			if (m_Decoder == nullptr)
+			{
+				m_Decoder = new ThreadPool(GLIB_TEXTURE_DECODE_THREADS);
+			}
+
+			m_Decoder->Enqueue([pending, path]()
+			{
+				int width, height, numChannels;
+				stbi_uc* data = stbi_load(path.c_str(), &width, &height, &numChannels, 4);
+				if (data != nullptr)
+				{
+					pending->image = { numChannels, width, height, data };
+				}
+				else
+				{
+					const char* reason = stbi_failure_reason();
+					pending->error = reason ? reason : "can't load image";
+				}
+				pending->decoded.store(true);
+			});
+
+			return pending->request;
+		}
+
+		void SetTextureUploadBudget(size_t bytes)
+		{
+			m_UploadBudget = bytes > 0 ? bytes : 1;
+		}
+
+		void ProcessTextureUploads()
+		{
+			if (m_PendingTextures.empty()) return;
+
+			size_t budget = m_UploadBudget;
+			std::vector<std::shared_ptr<PendingTexture>> finished;
+			{
+				ContextLock lock(this);
+				for (auto it = m_PendingTextures.begin(); it != m_PendingTextures.end();)
+				{
+					PendingTexture& pending = **it;
+					if (pending.texture == nullptr)
+					{
+						if (!pending.decoded.load() || !UploadTextureRows(pending, budget))
+						{
+							it++;
+							continue;
+						}
+					}
+
+					finished.push_back(*it);
+					it = m_PendingTextures.erase(it);
+				}
+			}
+
+			// Callbacks may start new loads, so they only run once the list isn't iterated anymore
+			for (const std::shared_ptr<PendingTexture>& pending : finished)
+			{
+				if (pending->texture != nullptr && pending->request->GetTexture() == nullptr && m_ManageAssets)
+				{
+					m_Textures.insert({ pending->request->GetPath(), pending->texture });
+				}
+				pending->request->Finish(pending->texture);
+
+				for (const TextureCallback& callback : pending->callbacks)
+				{
+					callback(pending->texture);
+				}
+			}
+		}
+
+		// Returns true once the texture is complete (or failed)
+		bool UploadTextureRows(PendingTexture& pending, size_t& budget)
+		{
+			ImageData& image = pending.image;
+			if (image.data == nullptr)
+			{
+				std::cout << pending.error << " (" << pending.request->GetPath() << ")" << std::endl;
+				return true;
+			}
+
+			// Loaded in the meantime by LoadTexture, a started upload is dropped so the path keeps a single texture
+			auto it = m_Textures.find(pending.request->GetPath());
+			if (it != m_Textures.end())
+			{
+				if (pending.id != 0)
+				{
+					ContextLock lock(this);
+					OpenGLProxy::DeleteTextures(1, &pending.id);
+					pending.id = 0;
+				}
+				pending.texture = it->second;
+				stbi_image_free(image.data);
+				image.data = nullptr;
+				return true;
+			}
+
+			size_t rowSize = (size_t)image.width * 4;
+			size_t size = rowSize * image.height;
+
+			// Atlas regions are small, they are copied in one go
+			if (m_UseAtlas && image.width <= m_AtlasThreshold && image.height <= m_AtlasThreshold)
+			{
+				if (budget < size && budget < m_UploadBudget) return false;
+
+				pending.texture = CreateTexture(image, pending.pixelart);
+				budget -= budget < size ? budget : size;
+				stbi_image_free(image.data);
+				image.data = nullptr;
+				return true;
+			}
+
+			// A row is never split, so a single row may go over the budget if nothing else was uploaded this frame
+			int rows = (int)(budget / rowSize);
+			if (rows == 0)
+			{
+				if (budget < m_UploadBudget) return false;
+				rows = 1;
+			}
+			rows = mini(rows, image.height - pending.row);
+			size_t chunk = rows * rowSize;
+
+			ContextLock lock(this);
+
+			if (pending.id == 0)
+			{
+				pending.id = CreateTextureObject(pending.pixelart);
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, image.width, image.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+				pending.request->SetUploading();
+			}
+			else
+			{
+				OpenGLProxy::ActiveTexture(GL_TEXTURE0);
+				OpenGLProxy::BindTexture(GL_TEXTURE_2D, pending.id);
+			}
+
+			// Room for a few frames, so the GPU can still read the previous chunks while the next one is written
+			if (m_UploadBuffer == nullptr || m_UploadBuffer->GetSize() < chunk * GLIB_STREAM_BUFFER_SEGMENTS)
+			{
+				delete m_UploadBuffer;
+				m_UploadBuffer = new StreamBuffer((chunk > m_UploadBudget ? chunk : m_UploadBudget) * GLIB_STREAM_BUFFER_SEGMENTS, GL_PIXEL_UNPACK_BUFFER);
+			}
+
+			size_t offset = m_UploadBuffer->Write(image.data + pending.row * rowSize, chunk, 4);
+
+			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_UploadBuffer->GetID());
+			glTexSubImage2D(GL_TEXTURE_2D, 0, 0, pending.row, image.width, rows, GL_RGBA, GL_UNSIGNED_BYTE, (const void*)offset);
+			glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+			pending.row += rows;
+			budget -= budget < chunk ? budget : chunk;
+			pending.request->SetProgress((float)pending.row / image.height);
+
+			if (pending.row < image.height)
+			{
+				OpenGLProxy::BindTexture(GL_TEXTURE_2D, 0);
+				return false;
+			}
+
+			glGenerateMipmap(GL_TEXTURE_2D);
+			OpenGLProxy::BindTexture(GL_TEXTURE_2D, 0);
+
+			pending.texture = new Texture(pending.id, image.width, image.height);
+			pending.id = 0;
+			stbi_image_free(image.data);
+			image.data = nullptr;
+			return true;
+		}
+
 		ImageData LoadTextureRaw(const std::string& path)
 		{
 			stbi_set_flip_vertically_on_load(false);
@@ -394,13 +728,34 @@ namespace glib
 
 		Texture* LoadTextureFromRawData(ImageData data, bool pixelart)
 		{
-			glfwMakeContextCurrent(m_Handle);
+			ContextLock lock(this);
+			unsigned int id = CreateTextureObject(pixelart);
+
+			if (data.channels == 3)
+			{
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, data.width, data.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data);
+			}
+			else if (data.channels == 4)
+			{
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, data.width, data.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data);
+			}
+			glGenerateMipmap(GL_TEXTURE_2D);
+
+			OpenGLProxy::BindTexture(GL_TEXTURE_2D, 0);
+
+			Texture* tex = new Texture(id, data.width, data.height);
+			return tex;
+		}
+
+		// Creates a texture and leaves it bound to GL_TEXTURE0, the storage still has to be allocated
+		unsigned int CreateTextureObject(bool pixelart)
+		{
 			unsigned int id;
 
 			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-			glActiveTexture(GL_TEXTURE0);
+			OpenGLProxy::ActiveTexture(GL_TEXTURE0);
 			glGenTextures(1, &id);
-			glBindTexture(GL_TEXTURE_2D, id);
+			OpenGLProxy::BindTexture(GL_TEXTURE_2D, id);
 
 			if (pixelart)
 			{
@@ -423,30 +778,189 @@ namespace glib
 				glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, largest);
 			}
 
-			if (data.channels == 3)
-			{
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, data.width, data.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data);
-			}
-			else if (data.channels == 4)
+			return id;
+		}
+
+		Texture* CreateTexture(ImageData data, bool pixelart)
+		{
+			if (m_UseAtlas && data.width <= m_AtlasThreshold && data.height <= m_AtlasThreshold)
 			{
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, data.width, data.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data.data);
-			}
-			glGenerateMipmap(GL_TEXTURE_2D);
+				ContextLock lock(this);
 
-			glBindTexture(GL_TEXTURE_2D, 0);
+				TextureAtlas*& atlas = pixelart ? m_PixelartAtlas : m_Atlas;
+				if (atlas == nullptr)
+				{
+					atlas = new TextureAtlas(m_AtlasPageSize, pixelart);
+				}
 
-			Texture* tex = new Texture(id, data.width, data.height);
-			return tex;
+				Texture* tex = atlas->Add(data);
+				if (tex != nullptr) return tex;
+			}
+
+			return LoadTextureFromRawData(data, pixelart);
 		}
 
 		void SetToCurrentContext()
 		{
+			// With a render thread the context has to be shared, so it's locked until SetNotToCurrentContext
+			if (m_Threaded)
+			{
+				// Already current here (e.g. called from an event handler), locking again would never be undone
+				if (m_ContextOwner.load() == std::this_thread::get_id()) return;
+
+				LockContext();
+				m_ExplicitLock = true;
+				return;
+			}
+
 			glfwMakeContextCurrent(m_Handle);
+			OpenGLProxy::MakeCurrent(m_Handle);
 		}
 
 		void SetNotToCurrentContext()
 		{
+			if (m_Threaded)
+			{
+				if (!m_ExplicitLock || m_ContextOwner.load() != std::this_thread::get_id()) return;
+
+				m_ExplicitLock = false;
+				UnlockContext();
+				return;
+			}
+
 			glfwMakeContextCurrent(NULL);
+			OpenGLProxy::MakeCurrent(NULL);
+		}
+
+		bool HasExplicitContextLock() const
+		{
+			return m_Threaded && m_ExplicitLock && m_ContextOwner.load() == std::this_thread::get_id();
+		}
+
+		void LockContext() const
+		{
+			m_ContextMutex.lock();
+			if (m_ContextDepth++ == 0)
+			{
+				m_ContextOwner = std::this_thread::get_id();
+				glfwMakeContextCurrent(m_Handle);
+				OpenGLProxy::MakeCurrent(m_Handle);
+			}
+		}
+
+		void UnlockContext() const
+		{
+			// A context can only be current on one thread, so it's released for the other one
+			if (--m_ContextDepth == 0)
+			{
+				m_ContextOwner = std::thread::id();
+				if (m_Threaded) glfwMakeContextCurrent(NULL);
+			}
+			m_ContextMutex.unlock();
+		}
+
+		void SetThreaded(bool threaded)
+		{
+			std::lock_guard<std::recursive_mutex> lock(m_ContextMutex);
+			m_Threaded = threaded;
+
+			if (threaded)
+			{
+				glfwMakeContextCurrent(NULL);
+			}
+			else
+			{
+				glfwMakeContextCurrent(m_Handle);
+				OpenGLProxy::MakeCurrent(m_Handle);
+			}
+		}
+
+		void BuildFramePacket(FramePacket& packet)
+		{
+			packet.Clear();
+
+			for (Camera* cam : m_DrawCameras)
+			{
+				FrameCamera frame{};
+				frame.camera = cam;
+				frame.view = cam->CalculateView();
+				frame.firstItem = packet.items.size();
+				frame.retained = cam->IsRetained() && cam->CalculateSignature(frame.signature);
+
+				for (Drawable* d : cam->GatherVisible())
+				{
+					if (d->kind == GLIB_DRAWABLE_SPRITE)
+					{
+						Sprite* s = static_cast<Sprite*>(d);
+
+						FrameItem item{};
+						item.kind = GLIB_DRAWABLE_SPRITE;
+						item.transform = s->GetWorldTransform();
+						item.transform.tx -= cam->pos.x * s->scrollFactor.x;
+						item.transform.ty -= cam->pos.y * s->scrollFactor.y;
+						item.color = s->color;
+						item.uvCoord = s->textureOffset;
+						item.uvSize = s->textureSize;
+
+						if (s->tex != nullptr)
+						{
+							// Map into the atlas region (a no-op for normal textures)
+							const Vec2& regionOffset = s->tex->GetUVOffset();
+							const Vec2& regionSize = s->tex->GetUVSize();
+							item.uvCoord = Vec2(regionOffset.x + item.uvCoord.x * regionSize.x, regionOffset.y + item.uvCoord.y * regionSize.y);
+							item.uvSize = Vec2(item.uvSize.x * regionSize.x, item.uvSize.y * regionSize.y);
+							item.texture = s->tex->GetID();
+						}
+
+						packet.items.push_back(item);
+					}
+					else if (d->kind == GLIB_DRAWABLE_TEXT)
+					{
+						Text* text = static_cast<Text*>(d);
+						if (text->font == nullptr) continue;
+
+						const std::vector<float>& vertices = text->GetMeshVertices();
+						size_t base = packet.textVertices.size() / 4;
+						packet.textVertices.insert(packet.textVertices.end(), vertices.begin(), vertices.end());
+
+						FrameItem item{};
+						item.kind = GLIB_DRAWABLE_TEXT;
+						item.transform.tx = text->pos.x - cam->pos.x * cam->zoom;
+						item.transform.ty = text->pos.y - cam->pos.y * cam->zoom;
+						item.color = text->color;
+
+						for (const TextMeshRange& range : text->GetMeshRanges())
+						{
+							item.texture = range.tex;
+							item.firstVertex = base + range.first;
+							item.vertexCount = range.count;
+							packet.items.push_back(item);
+						}
+					}
+					else
+					{
+						// Video players and custom drawables draw themselves, which can't happen off the update thread
+						packet.skipped++;
+					}
+				}
+
+				frame.itemCount = packet.items.size() - frame.firstItem;
+				packet.cameras.push_back(frame);
+			}
+		}
+
+		void DrawFramePacket(const FramePacket& packet) const
+		{
+			ContextLock lock(this);
+
+			OpenGLProxy::ClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+			OpenGLProxy::Clear(GL_COLOR_BUFFER_BIT);
+
+			m_Pipeline->Flush(packet);
+			m_TargetPool->EndFrame();
+
+			glfwSwapBuffers(m_Handle);
+			OpenGLProxy::EndFrame();
 		}
 
 		void HideCursor()
@@ -466,7 +980,7 @@ namespace glib
 				return m_Fonts.at(path);
 			}
 
-			glfwMakeContextCurrent(m_Handle);
+			ContextLock lock(this);
 			
 			Font* fnt = new Font(path, charset, charsetLen, size, pixelart);
 
@@ -480,6 +994,7 @@ namespace glib
 
 			if (del)
 			{
+				ContextLock lock(this);
 				for (Shader* shd : m_Shaders)
 				{
 					delete shd;
@@ -499,6 +1014,7 @@ namespace glib
 			}
 
 			m_Shaders.clear();
+			m_ShadersBySource.clear();
 			m_Textures.clear();
 			m_Fonts.clear();
 			m_Models.clear();
@@ -560,7 +1076,7 @@ namespace glib
 				return nullptr;
 			}
 
-			Texture* tex = LoadTextureFromRawData({ numChannels, width, height, data }, pixelart);
+			Texture* tex = CreateTexture({ numChannels, width, height, data }, pixelart);
 
 			if (m_ManageAssets)
 			{
@@ -589,7 +1105,7 @@ namespace glib
 				return m_Fonts.at(path);
 			}
 
-			glfwMakeContextCurrent(m_Handle);
+			ContextLock lock(this);
 
 			Font* fnt = new Font(packagePath, path, charset, charsetLen, size, pixelart);
 
@@ -615,6 +1131,7 @@ namespace glib
 		Model* LoadModel(const std::string& path, bool pixelart)
 		{
 			if (m_Models.count(path) > 0) return m_Models.at(path);
+			ContextLock lock(this);
 			Model* model = Model::LoadModel(path, pixelart);
 			m_Models.insert({ path, model });
 			return model;
@@ -740,6 +1257,11 @@ RenderPipeline* glib::Window::GetRenderPipeline()
 	return impl->GetRenderPipeline();
 }
 
+RenderTargetPool* glib::Window::GetRenderTargetPool()
+{
+	return impl->GetRenderTargetPool();
+}
+
 void glib::Window::Draw() const
 {
 	impl->Draw();
@@ -787,7 +1309,12 @@ const Vec2& glib::Window::GetViewportSize()
 
 Shader* glib::Window::LoadShader(const std::string& vertexCode, const std::string& fragmentCode)
 {
-	return impl->LoadShader(vertexCode, fragmentCode);
+	return impl->LoadShader(vertexCode, fragmentCode, false);
+}
+
+Shader* glib::Window::LoadSharedShader(const std::string& vertexCode, const std::string& fragmentCode)
+{
+	return impl->LoadShader(vertexCode, fragmentCode, true);
 }
 
 Shader* glib::Window::LoadShaderFromFiles(const std::string& vertexPath, const std::string& fragmentPath)
@@ -829,6 +1356,16 @@ Texture* glib::Window::LoadTexture(const std::string& path, bool pixelart)
 	return impl->LoadTexture(path, pixelart);
 }
 
+std::shared_ptr<TextureRequest> glib::Window::LoadTextureAsync(const std::string& path, bool pixelart, const TextureCallback& callback)
+{
+	return impl->LoadTextureAsync(path, pixelart, callback);
+}
+
+void glib::Window::SetTextureUploadBudget(size_t bytes)
+{
+	impl->SetTextureUploadBudget(bytes);
+}
+
 Texture* glib::Window::LoadTextureFromPackage(const std::string& packagePath, const std::string& path, bool pixelart)
 {
 	return impl->LoadTextureFromPackage(packagePath, path, pixelart);
@@ -938,3 +1475,33 @@ void* glib::Window::GetHandle()
 {
 	return impl->GetHandle();
 }
+
+void glib::Window::LockContext()
+{
+	impl->LockContext();
+}
+
+void glib::Window::UnlockContext()
+{
+	impl->UnlockContext();
+}
+
+void glib::Window::SetThreaded(bool threaded)
+{
+	impl->SetThreaded(threaded);
+}
+
+bool glib::Window::HasExplicitContextLock() const
+{
+	return impl->HasExplicitContextLock();
+}
+
+void glib::Window::BuildFramePacket(FramePacket& packet)
+{
+	impl->BuildFramePacket(packet);
+}
+
+void glib::Window::DrawFramePacket(const FramePacket& packet) const
+{
+	impl->DrawFramePacket(packet);
+}
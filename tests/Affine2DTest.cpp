@@ -0,0 +1,177 @@
+// Checks MakeSpriteTransform against the Mat4 composition the renderer used before, and the SIMD lanes of
+// BatchSpriteTransforms against the scalar path. Needs src/math/Rect.cpp only, no OpenGL.
+
+#include "glib/math/Affine2D.h"
+
+#include <vector>
+#include <iostream>
+
+using namespace glib;
+
+static int failures = 0;
+
+#define CHECK(cond) if (!(cond)) { std::cout << "FAILED: " << #cond << " (line " << __LINE__ << ")" << std::endl; failures++; }
+
+struct TestSprite
+{
+	Vec2 pos;
+	Vec2 size;
+	Vec2 scale;
+	Vec2 offset;
+	Vec2 pivot;
+	float rotation;
+	uint8_t flip;
+};
+
+// The translate, rotate, scale chain of the old CameraRenderer::DrawSprite, with the pivot made configurable.
+// A flip mirrors the unit square, like the flipped vertex array did.
+static Mat4 ComposeSpriteMatrix(const TestSprite& s)
+{
+	Vec2 scaled = s.size * s.scale;
+	Vec2 diff = scaled - s.size;
+
+	Mat4 m;
+	m.Translate(Vec2(s.pos.x - diff.x / 2.0f, s.pos.y - diff.y / 2.0f));
+	m.Translate(Vec2(scaled.x * s.pivot.x, scaled.y * s.pivot.y));
+	m.Rotate(s.rotation);
+	m.Translate(Vec2(-scaled.x * s.pivot.x, -scaled.y * s.pivot.y));
+	m.Translate(s.offset);
+	m.Scale(scaled);
+
+	if (s.flip & GLIB_AFFINE_FLIP_X)
+	{
+		m.Translate(Vec2(1.0f, 0.0f));
+		m.Scale(Vec2(-1.0f, 1.0f));
+	}
+	if (s.flip & GLIB_AFFINE_FLIP_Y)
+	{
+		m.Translate(Vec2(0.0f, 1.0f));
+		m.Scale(Vec2(1.0f, -1.0f));
+	}
+	return m;
+}
+
+// The translation sums terms of up to a few thousand that can cancel out, so the error is relative to the inputs, not to the result
+static float GetMagnitude(const TestSprite& s)
+{
+	return std::fabs(s.pos.x) + std::fabs(s.pos.y) + s.size.x * s.scale.x * (1.0f + std::fabs(s.pivot.x)) +
+		s.size.y * s.scale.y * (1.0f + std::fabs(s.pivot.y)) + std::fabs(s.offset.x) + std::fabs(s.offset.y);
+}
+
+static bool NearlyEqual(float x, float y, float magnitude)
+{
+	return std::fabs(x - y) <= 1e-6f * magnitude;
+}
+
+static bool NearlyEqual(const Affine2D& l, const Affine2D& r, float magnitude)
+{
+	return NearlyEqual(l.a, r.a, magnitude) && NearlyEqual(l.b, r.b, magnitude) && NearlyEqual(l.c, r.c, magnitude) &&
+		NearlyEqual(l.d, r.d, magnitude) && NearlyEqual(l.tx, r.tx, magnitude) && NearlyEqual(l.ty, r.ty, magnitude);
+}
+
+static unsigned int seed = 4242;
+
+static float Random(float min, float max)
+{
+	seed = seed * 1103515245 + 12345;
+	return min + (max - min) * (float)((seed >> 8) & 0xFFFF) / 65535.0f;
+}
+
+static TestSprite RandomSprite(const Vec2& pivot)
+{
+	TestSprite s;
+	s.pos = Vec2(Random(-2000.0f, 2000.0f), Random(-2000.0f, 2000.0f));
+	s.size = Vec2(Random(1.0f, 300.0f), Random(1.0f, 300.0f));
+	s.scale = Vec2(Random(0.25f, 4.0f), Random(0.25f, 4.0f));
+	s.offset = Vec2(Random(-50.0f, 50.0f), Random(-50.0f, 50.0f));
+	s.pivot = pivot;
+	s.rotation = Random(-720.0f, 720.0f);
+	s.flip = (uint8_t)((seed >> 4) & (GLIB_AFFINE_FLIP_X | GLIB_AFFINE_FLIP_Y));
+	return s;
+}
+
+static void TestMatchesMat4()
+{
+	const Vec2 pivots[] = { Vec2(0.5f, 0.5f), Vec2(0.0f, 0.0f), Vec2(1.0f, 0.25f), Vec2(-0.5f, 1.75f) };
+
+	for (const Vec2& pivot : pivots)
+	{
+		for (int i = 0; i < 500; i++)
+		{
+			TestSprite s = RandomSprite(pivot);
+			s.flip = (uint8_t)(i % 4); // Every flip combination for every pivot
+
+			Mat4 expected = ComposeSpriteMatrix(s);
+			Mat4 actual = MakeSpriteTransform(s.pos, s.size, s.scale, s.offset, s.pivot, s.rotation, s.flip).ToMat4();
+
+			// Z is flattened by Mat4::Scale, the 2D transform doesn't touch it either way
+			const int compared[] = { 0, 1, 3, 4, 5, 7, 12, 13, 15 };
+			bool equal = true;
+			for (int index : compared)
+			{
+				equal = equal && NearlyEqual(expected.GetData()[index], actual.GetData()[index], GetMagnitude(s));
+			}
+			CHECK(equal);
+			if (!equal) return;
+		}
+	}
+
+	// No rotation, scale or offset has to give exactly the sprite rectangle
+	Affine2D plain = MakeSpriteTransform(Vec2(10.0f, 20.0f), Vec2(30.0f, 40.0f), Vec2(1.0f, 1.0f), Vec2(0.0f, 0.0f), Vec2(0.5f, 0.5f), 0.0f);
+	CHECK(plain.a == 30.0f && plain.b == 0.0f && plain.c == 0.0f && plain.d == 40.0f && plain.tx == 10.0f && plain.ty == 20.0f);
+}
+
+static void TestBatchMatchesScalar()
+{
+	// Counts and ranges that are not multiples of four, so the vector loop and the scalar tail both run
+	const size_t counts[] = { 1, 3, 4, 5, 7, 8, 13, 64, 67 };
+
+	for (size_t count : counts)
+	{
+		SpriteTransformBatch batch;
+		batch.pivot = Vec2(0.3f, 0.8f);
+
+		std::vector<TestSprite> sprites;
+		for (size_t i = 0; i < count; i++)
+		{
+			TestSprite s = RandomSprite(batch.pivot);
+			s.flip = (uint8_t)(i % 4);
+			sprites.push_back(s);
+			batch.Push(s.pos, s.size, s.scale, s.offset, s.rotation, s.flip);
+		}
+
+		std::vector<Affine2D> whole(count);
+		BatchSpriteTransforms(batch, whole.data());
+
+		// Odd ranges move the lanes to other sprites than a batch from 0 would
+		std::vector<Affine2D> split(count);
+		size_t middle = count / 3 + 1 < count ? count / 3 + 1 : count;
+		BatchSpriteTransforms(batch, 0, middle, split.data());
+		BatchSpriteTransforms(batch, middle, count, split.data());
+
+		for (size_t i = 0; i < count; i++)
+		{
+			const TestSprite& s = sprites[i];
+			Affine2D scalar = MakeSpriteTransform(s.pos, s.size, s.scale, s.offset, batch.pivot, s.rotation, s.flip);
+			CHECK(NearlyEqual(whole[i], scalar, GetMagnitude(s)));
+			CHECK(NearlyEqual(split[i], scalar, GetMagnitude(s)));
+		}
+	}
+}
+
+int main()
+{
+#if defined(GLIB_SIMD_SSE)
+	std::cout << "BatchSpriteTransforms uses SSE" << std::endl;
+#elif defined(GLIB_SIMD_NEON)
+	std::cout << "BatchSpriteTransforms uses NEON" << std::endl;
+#else
+	std::cout << "BatchSpriteTransforms is scalar only" << std::endl;
+#endif
+
+	TestMatchesMat4();
+	TestBatchMatchesScalar();
+
+	if (failures == 0) std::cout << "Affine2DTest passed" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
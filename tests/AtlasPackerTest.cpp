@@ -0,0 +1,95 @@
+// Checks the skyline packer used by TextureAtlas. Only needs src/graphics/AtlasPacker.cpp and src/math/Vec2i.cpp, no OpenGL.
+
+#include "glib/graphics/AtlasPacker.h"
+
+#include <vector>
+#include <iostream>
+
+using namespace glib;
+
+static int failures = 0;
+
+#define CHECK(cond) if (!(cond)) { std::cout << "FAILED: " << #cond << " (line " << __LINE__ << ")" << std::endl; failures++; }
+
+struct PackedRect
+{
+	int x;
+	int y;
+	int width;
+	int height;
+};
+
+// TextureAtlas packs every image with a border of this size on each side
+#define TEST_PADDING 2
+#define TEST_PAGE_SIZE 256
+
+int main()
+{
+	AtlasPacker packer(TEST_PAGE_SIZE, TEST_PAGE_SIZE);
+
+	// Mixed sizes in a fixed pseudo random order, so the skyline gets uneven
+	std::vector<PackedRect> images;
+	unsigned int seed = 12345;
+	for (int i = 0; i < 60; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		int width = 4 + (seed >> 16) % 29;
+		seed = seed * 1103515245 + 12345;
+		int height = 4 + (seed >> 16) % 29;
+
+		Vec2i pos;
+		bool packed = packer.Pack(width + TEST_PADDING * 2, height + TEST_PADDING * 2, pos);
+		CHECK(packed);
+		if (!packed) continue;
+
+		images.push_back({ pos.x + TEST_PADDING, pos.y + TEST_PADDING, width, height });
+	}
+
+	for (size_t i = 0; i < images.size(); i++)
+	{
+		const PackedRect& a = images[i];
+
+		// Inside the page, including the padding
+		CHECK(a.x - TEST_PADDING >= 0);
+		CHECK(a.y - TEST_PADDING >= 0);
+		CHECK(a.x + a.width + TEST_PADDING <= TEST_PAGE_SIZE);
+		CHECK(a.y + a.height + TEST_PADDING <= TEST_PAGE_SIZE);
+
+		for (size_t j = i + 1; j < images.size(); j++)
+		{
+			const PackedRect& b = images[j];
+
+			// Two images may not overlap and have to be at least two paddings apart on one axis
+			bool apartX = a.x + a.width + TEST_PADDING * 2 <= b.x || b.x + b.width + TEST_PADDING * 2 <= a.x;
+			bool apartY = a.y + a.height + TEST_PADDING * 2 <= b.y || b.y + b.height + TEST_PADDING * 2 <= a.y;
+			CHECK(apartX || apartY);
+		}
+	}
+
+	float occupancy = packer.GetOccupancy();
+	CHECK(occupancy > 0.0f && occupancy <= 1.0f);
+
+	// Invalid sizes never fit
+	Vec2i pos;
+	CHECK(!packer.Pack(0, 10, pos));
+	CHECK(!packer.Pack(10, -1, pos));
+	CHECK(!packer.Pack(TEST_PAGE_SIZE + 1, 1, pos));
+
+	// Filling the page with equal tiles uses all of it, the next one has to fail
+	AtlasPacker full(64, 64);
+	for (int i = 0; i < 16; i++)
+	{
+		CHECK(full.Pack(16, 16, pos));
+	}
+	CHECK(full.GetOccupancy() == 1.0f);
+	CHECK(!full.Pack(1, 1, pos));
+
+	// Reset frees the page again
+	full.Reset();
+	CHECK(full.GetOccupancy() == 0.0f);
+	CHECK(full.Pack(64, 64, pos));
+	CHECK(pos.x == 0 && pos.y == 0);
+
+	if (failures == 0) std::cout << "AtlasPackerTest passed" << std::endl;
+	return failures == 0 ? 0 : 1;
+}
\ No newline at end of file
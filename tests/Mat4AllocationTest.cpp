@@ -0,0 +1,75 @@
+// Counts heap allocations while a frame worth of sprite and 3D matrices is built. Header only, no OpenGL.
+// Mat4 used to wrap a heap allocated glm matrix, so every temporary allocated once.
+
+#include "glib/math/Mat4.h"
+
+#include <cstdlib>
+#include <new>
+#include <iostream>
+
+using namespace glib;
+
+static size_t allocations = 0;
+
+void* operator new(size_t size)
+{
+	allocations++;
+	void* ptr = std::malloc(size > 0 ? size : 1);
+	if (ptr == nullptr) throw std::bad_alloc();
+	return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	std::free(ptr);
+}
+
+#define TEST_SPRITES 10000
+
+int main()
+{
+	Mat4 view;
+	view.Translate(Vec2(-120.0f, -80.0f));
+
+	float checksum = 0.0f;
+	size_t before = allocations;
+
+	// What CameraRenderer::DrawSprite and Camera3DRenderer do per drawable
+	for (int i = 0; i < TEST_SPRITES; i++)
+	{
+		Mat4 model;
+		model.Translate(Vec2((float)i, (float)(i % 100)));
+		model.Translate(Vec2(16.0f, 16.0f));
+		model.Rotate((float)(i % 360));
+		model.Translate(Vec2(-16.0f, -16.0f));
+		model.Scale(Vec2(32.0f, 32.0f));
+
+		Mat4 model3D;
+		model3D.Translate(Vec3(1.0f, 2.0f, 3.0f));
+		model3D.Rotate((float)i, Vec3(0.0f, 1.0f, 0.0f));
+		model3D.Scale(Vec3(2.0f, 2.0f, 2.0f));
+
+		Mat4 mvp = view * model;
+		Mat4 copy = mvp.Copy();
+		copy = copy * model3D;
+
+		checksum += copy.GetData()[12];
+	}
+
+	size_t count = allocations - before;
+	std::cout << "Mat4 allocations for " << TEST_SPRITES << " sprites: " << count << " (checksum " << checksum << ")" << std::endl;
+
+	if (count != 0)
+	{
+		std::cout << "FAILED: Mat4 operations allocated" << std::endl;
+		return 1;
+	}
+
+	std::cout << "Mat4AllocationTest passed" << std::endl;
+	return 0;
+}
\ No newline at end of file